@@ -32,7 +32,10 @@ public class FicsItCam : ModuleRules
             "Renderer",
             "RenderCore",
             "ImageWrapper",
-            "Niagara"
+            "Niagara",
+            "FicsItCamMath",
+            "Json",
+            "Projects"
 		});
 			
 		if (Target.Type == TargetRules.TargetType.Editor) {
@@ -40,6 +43,10 @@ public class FicsItCam : ModuleRules
 		}
         PublicDependencyModuleNames.AddRange(new string[] {"FactoryGame", "SML"});
         
-        OptimizeCode = CodeOptimization.Never;
+        bUseUnity = true;
+        
+        // Optimized for Development and Shipping, Debug and DebugGame builds stay unoptimized for debugging.
+        // The SML hook functions keep their own "#pragma optimize" guards.
+        OptimizeCode = CodeOptimization.InNonDebugBuilds;
     }
 }
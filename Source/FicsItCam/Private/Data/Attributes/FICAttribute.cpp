@@ -1,15 +1,36 @@
 #include "FicsItCam/Public/Data/Attributes/FICAttribute.h"
 
+uint32 FFICAttribute::RevisionCounter = 0;
+
 void FFICAttribute::RecalculateAllKeyframes() {
 	TArray<int64> Keys;
 	GetKeyframes().GetKeys(Keys);
 	for (int64 Time : Keys) {
 		RecalculateKeyframe(Time);
 	}
+	DirtyKeyframes.Empty();
 
 	OnUpdateBroadcast();
 }
 
+void FFICAttribute::RecalculateDirtyKeyframes() {
+	if (DirtyKeyframes.Num() < 1) return;
+	TSet<FICFrame> Frames;
+	for (FICFrame Frame : DirtyKeyframes) {
+		Frames.Add(Frame);
+		FICFrame Neighbour;
+		if (GetPrevKeyframe(Frame, Neighbour)) Frames.Add(Neighbour);
+		if (GetNextKeyframe(Frame, Neighbour)) Frames.Add(Neighbour);
+	}
+	DirtyKeyframes.Empty();
+
+	LockUpdateEvent();
+	for (FICFrame Frame : Frames) {
+		RecalculateKeyframe(Frame);
+	}
+	UnlockUpdateEvent();
+}
+
 TSharedPtr<FFICKeyframe> FFICAttribute::GetPrevKeyframe(FICFrame Time, FICFrame& OutTime) {
 	TMap<FICFrame, TSharedRef<FFICKeyframe>> Keyframes = GetKeyframes();
 	TArray<FICFrame> Keys;
@@ -1,5 +1,7 @@
 #include "Data/Attributes/FICAttributeBool.h"
 
+#include "Algo/BinarySearch.h"
+#include "Data/FICSceneArchive.h"
 #include "Editor/Data/FICEditorAttributeBool.h"
 
 EFICKeyframeType FFICAttributeBool::GetAllowedKeyframeTypes() const {
@@ -22,7 +24,10 @@ TSharedRef<FFICKeyframe> FFICAttributeBool::AddKeyframe(FICFrame Time) {
 }
 
 void FFICAttributeBool::RemoveKeyframe(FICFrame Time) {
-	Keyframes.Remove(Time);
+	if (Keyframes.Remove(Time) > 0) {
+		FrameIndex.Remove(Time);
+		MarkKeyframeDirty(Time);
+	}
 	OnUpdateBroadcast();
 }
 
@@ -35,9 +40,8 @@ void FFICAttributeBool::MoveKeyframe(FICFrame From, FICFrame To) {
 }
 
 void FFICAttributeBool::RecalculateKeyframe(FICFrame Time) {
-	for (TTuple<int64, FFICKeyframeBool>& keyframe : Keyframes) {
-		keyframe.Value.KeyframeType = FIC_KF_STEP;
-	}
+	FFICKeyframeBool* Keyframe = Keyframes.Find(Time);
+	if (Keyframe) Keyframe->KeyframeType = FIC_KF_STEP;
 	OnUpdateBroadcast();
 }
 
@@ -45,12 +49,23 @@ FICValue FFICAttributeBool::GetFloatValue(FICFrameFloat Time) {
 	return GetValue(Time) ? 1.0f : 0.0f;
 }
 
+TSharedPtr<FFICKeyframe> FFICAttributeBool::GetNextKeyframe(FICFrame Time, FICFrame& OutTime) {
+	if (!FFICFrameIndex::FindNext(FrameIndex.Get(Keyframes), Time, OutTime)) return nullptr;
+	return MakeShared<FFICKeyframeBoolTrampoline>(this, OutTime);
+}
+
+TSharedPtr<FFICKeyframe> FFICAttributeBool::GetPrevKeyframe(FICFrame Time, FICFrame& OutTime) {
+	if (!FFICFrameIndex::FindPrev(FrameIndex.Get(Keyframes), Time, OutTime)) return nullptr;
+	return MakeShared<FFICKeyframeBoolTrampoline>(this, OutTime);
+}
+
 void FFICAttributeBool::Set(TSharedRef<FFICAttribute> InAttrib) {
 	FOnUpdate OnUpdateBuf = OnUpdate;
 	if (InAttrib->GetAttributeType() == GetAttributeType()) {
 		*this = *StaticCastSharedRef<FFICAttributeBool>(InAttrib);
 	}
 	OnUpdate = OnUpdateBuf;
+	DirtyKeyframes.Empty();
 	OnUpdateBroadcast();
 }
 
@@ -63,6 +78,8 @@ TSharedRef<FFICEditorAttributeBase> FFICAttributeBool::CreateEditorAttribute() {
 }
 
 FFICKeyframeBool* FFICAttributeBool::SetKeyframe(FICFrame Time, FFICKeyframeBool Keyframe) {
+	if (!Keyframes.Contains(Time)) FrameIndex.Add(Time);
+	MarkKeyframeDirty(Time);
 	FFICKeyframeBool* KF = &Keyframes.FindOrAdd(Time);
 	*KF = Keyframe;
 	OnUpdateBroadcast();
@@ -70,17 +87,38 @@ FFICKeyframeBool* FFICAttributeBool::SetKeyframe(FICFrame Time, FFICKeyframeBool
 }
 
 bool FFICAttributeBool::GetValue(FICFrameFloat Time) {
-	FICFrame Frame = TNumericLimits<FICFrame>::Min();
-	bool Value = FallBackValue;
+	const TArray<FICFrame>& Frames = FrameIndex.Get(Keyframes);
+	if (Frames.Num() < 1) return FallBackValue;
+	// last keyframe at or before the given time, or the first keyframe if there is none
+	int32 Index = FMath::Max(Algo::UpperBound(Frames, Time) - 1, 0);
+	return Keyframes[Frames[Index]].Value;
+}
+
+void FFICAttributeBool::SerializeKeyframes(FArchive& Ar) {
 	TArray<FICFrame> Frames;
-	Keyframes.GetKeys(Frames);
-	Frames.Sort();
-	for (FICFrame KeyframeFrame : Frames) {
-		const FFICKeyframeBool& Keyframe = Keyframes[KeyframeFrame];
-		if (KeyframeFrame > Frame && (KeyframeFrame <= Time || Frame == TNumericLimits<FICFrame>::Min())) {
-			Frame = KeyframeFrame;
-			Value = Keyframe.Value;
+	if (Ar.IsSaving()) Frames = FrameIndex.Get(Keyframes);
+	FFICEncoding::SerializeFrames(Ar, Frames);
+	if (Ar.IsError()) return;
+
+	// lower 3 bits keyframe type, 4th bit the value
+	TArray<uint8> Flags;
+	if (Ar.IsSaving()) {
+		Flags.Reserve(Frames.Num());
+		for (FICFrame Frame : Frames) {
+			const FFICKeyframeBool& Keyframe = Keyframes[Frame];
+			Flags.Add(FFICSceneArchive::KeyframeTypeToIndex(Keyframe.KeyframeType) | (Keyframe.Value ? 0x8 : 0));
+		}
+	}
+	FFICEncoding::SerializeNibbles(Ar, Flags, Frames.Num());
+
+	if (Ar.IsLoading() && !Ar.IsError()) {
+		Keyframes.Empty(Frames.Num());
+		for (int32 i = 0; i < Frames.Num(); ++i) {
+			FFICKeyframeBool& Keyframe = Keyframes.Add(Frames[i], FFICKeyframeBool(!!(Flags[i] & 0x8)));
+			Keyframe.KeyframeType = FFICSceneArchive::IndexToKeyframeType(Flags[i]);
 		}
+		FrameIndex.Invalidate();
+		DirtyKeyframes.Empty();
+		MarkChanged();
 	}
-	return Value;
 }
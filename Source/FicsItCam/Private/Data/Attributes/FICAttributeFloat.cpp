@@ -1,6 +1,6 @@
 #include "FicsItCam/Public/Data/Attributes/FICAttributeFloat.h"
 
-#include "FicsItCam/Public/FICUtils.h"
+#include "Data/FICSceneArchive.h"
 
 TMap<FICFrame, TSharedRef<FFICKeyframe>> FFICFloatAttribute::GetKeyframes() {
 	TMap<FICFrame, TSharedRef<FFICKeyframe>> OutKeyframes;
@@ -22,7 +22,10 @@ TSharedRef<FFICKeyframe> FFICFloatAttribute::AddKeyframe(FICFrame Time) {
 }
 
 void FFICFloatAttribute::RemoveKeyframe(FICFrame Time) {
-	Keyframes.Remove(Time);
+	if (Keyframes.Remove(Time) > 0) {
+		FrameIndex.Remove(Time);
+		MarkKeyframeDirty(Time);
+	}
 	OnUpdateBroadcast();
 }
 
@@ -37,70 +40,22 @@ void FFICFloatAttribute::MoveKeyframe(FICFrame From, FICFrame To) {
 void FFICFloatAttribute::RecalculateKeyframe(FICFrame Time) {
 	FFICFloatKeyframe* CurrentKeyframe = Keyframes.Find(Time);
 	if (!CurrentKeyframe) return;
+	if (CurrentKeyframe->KeyframeType & (FIC_KF_CUSTOM | FIC_KF_LINEAR | FIC_KF_MIRROR | FIC_KF_STEP) & ~FIC_KF_HANDLES) return;
 
-	FICFrame PTime;
+	FICFrame PTime = 0;
 	FFICFloatKeyframe* PK = StaticCastSharedPtr<FFICFloatKeyframeTrampoline>(GetPrevKeyframe(Time, PTime)).Get()->GetKeyframe();
-	int64 NTime;
+	FICFrame NTime = 0;
 	FFICFloatKeyframe* NK = StaticCastSharedPtr<FFICFloatKeyframeTrampoline>(GetNextKeyframe(Time, NTime)).Get()->GetKeyframe();
-	
-	if (!CurrentKeyframe) return;
-	if (CurrentKeyframe->KeyframeType & (FIC_KF_CUSTOM | FIC_KF_LINEAR | FIC_KF_MIRROR | FIC_KF_STEP) & ~FIC_KF_HANDLES) return;
-	float Factor = 1.0/3.0;
-	//Factor = 0.5;
-	if (PK) {
-		float PKTimeDiff = Time - PTime;
-		float PKValueDiff = CurrentKeyframe->Value - PK->Value;
-		if (NK) {
-			float NKTimeDiff = NTime - Time;
-			float NKValueDiff = NK->Value - CurrentKeyframe->Value;
-			float KValueDiff = (PKValueDiff + NKValueDiff) / 2.0;
-			float KTimeDiff = NTime - PTime;
-
-			//FMath::Clamp(K->Value + PKValueDiff, FMath::Min(PK->Value, NK->Value), FMath::Max(PK->Value, NK->Value)) - K->Value;
-
-			CurrentKeyframe->OutTanTime = NKTimeDiff * Factor;
-			CurrentKeyframe->InTanTime = PKTimeDiff * Factor;
-
-			float Ratio = PKTimeDiff / KTimeDiff;
-			float Pitch = (PKValueDiff/PKTimeDiff) * (1-Ratio) + (NKValueDiff/NKTimeDiff) * Ratio;
-			
-			if (CurrentKeyframe->KeyframeType == FIC_KF_EASE) {
-				if ((CurrentKeyframe->Value < PK->Value && CurrentKeyframe->Value < NK->Value) || (CurrentKeyframe->Value > PK->Value && CurrentKeyframe->Value > NK->Value)) {
-					CurrentKeyframe->InTanValue = CurrentKeyframe->OutTanValue = 0;
-				} else {
-					CurrentKeyframe->InTanValue = FMath::Clamp(CurrentKeyframe->Value - Pitch * CurrentKeyframe->InTanTime, FMath::Min(PK->Value, NK->Value), FMath::Max(PK->Value, NK->Value)) - CurrentKeyframe->Value;
-					CurrentKeyframe->OutTanValue = FMath::Clamp(CurrentKeyframe->Value + Pitch * CurrentKeyframe->OutTanTime, FMath::Min(PK->Value, NK->Value), FMath::Max(PK->Value, NK->Value)) - CurrentKeyframe->Value;
-					float InPitch = -CurrentKeyframe->InTanValue/CurrentKeyframe->InTanTime;
-					float OutPitch = CurrentKeyframe->OutTanValue/CurrentKeyframe->OutTanTime;
-					Pitch = FMath::Abs(InPitch) < FMath::Abs(OutPitch) ? InPitch : OutPitch;
-					CurrentKeyframe->InTanValue = Pitch * CurrentKeyframe->InTanTime;
-					CurrentKeyframe->OutTanValue = Pitch * CurrentKeyframe->OutTanTime;
-				}
-			} else if (CurrentKeyframe->KeyframeType == FIC_KF_EASEINOUT) {
-				CurrentKeyframe->OutTanValue = 0;
-				CurrentKeyframe->InTanValue = 0;
-			}
-		} else {
-			if (CurrentKeyframe->KeyframeType == FIC_KF_EASE) {
-				CurrentKeyframe->InTanTime = CurrentKeyframe->InTanValue = 0;
-			} else if (CurrentKeyframe->KeyframeType == FIC_KF_EASEINOUT) {
-				CurrentKeyframe->InTanTime = PKTimeDiff * Factor;
-				CurrentKeyframe->InTanValue = 0;
-			}
-		}
-	} else {
-		if (NK) {
-			float NKTimeDiff = NTime - Time;
-			float NKValueDiff = NK->Value - CurrentKeyframe->Value;
-		
-			if (CurrentKeyframe->KeyframeType == FIC_KF_EASE) {
-				CurrentKeyframe->OutTanTime = CurrentKeyframe->OutTanValue = 0;
-			} else if (CurrentKeyframe->KeyframeType == FIC_KF_EASEINOUT) {
-				CurrentKeyframe->OutTanTime = NKTimeDiff * Factor;
-				CurrentKeyframe->OutTanValue = 0;
-			}
-		}
-	}
+
+	FFICCurveKey Key = ToCurveKey(*CurrentKeyframe);
+	FFICCurveKey PrevKey, NextKey;
+	if (PK) PrevKey = ToCurveKey(*PK);
+	if (NK) NextKey = ToCurveKey(*NK);
+	FFICCurveMath::RecalculateTangents(Key.TangentMode, Time, Key, PK ? &PrevKey : nullptr, PTime, NK ? &NextKey : nullptr, NTime);
+	CurrentKeyframe->InTanTime = Key.InTanTime;
+	CurrentKeyframe->InTanValue = Key.InTanValue;
+	CurrentKeyframe->OutTanTime = Key.OutTanTime;
+	CurrentKeyframe->OutTanValue = Key.OutTanValue;
 	OnUpdateBroadcast();
 }
 
@@ -108,12 +63,23 @@ FICValue FFICFloatAttribute::GetFloatValue(FICFrameFloat Time) {
 	return GetValue(Time);
 }
 
+TSharedPtr<FFICKeyframe> FFICFloatAttribute::GetNextKeyframe(FICFrame Time, FICFrame& OutTime) {
+	if (!FFICFrameIndex::FindNext(FrameIndex.Get(Keyframes), Time, OutTime)) return nullptr;
+	return MakeShared<FFICFloatKeyframeTrampoline>(this, OutTime);
+}
+
+TSharedPtr<FFICKeyframe> FFICFloatAttribute::GetPrevKeyframe(FICFrame Time, FICFrame& OutTime) {
+	if (!FFICFrameIndex::FindPrev(FrameIndex.Get(Keyframes), Time, OutTime)) return nullptr;
+	return MakeShared<FFICFloatKeyframeTrampoline>(this, OutTime);
+}
+
 void FFICFloatAttribute::Set(TSharedRef<FFICAttribute> InAttrib) {
 	FOnUpdate OnUpdateBuf = OnUpdate;
 	if (InAttrib->GetAttributeType() == GetAttributeType()) {
 		*this = *StaticCastSharedRef<FFICFloatAttribute>(InAttrib);
 	}
 	OnUpdate = OnUpdateBuf;
+	DirtyKeyframes.Empty();
 	OnUpdateBroadcast();
 }
 
@@ -126,6 +92,8 @@ TSharedRef<FFICEditorAttributeBase> FFICFloatAttribute::CreateEditorAttribute()
 }
 
 FFICFloatKeyframe* FFICFloatAttribute::SetKeyframe(FICFrame Time, FFICFloatKeyframe Keyframe) {
+	if (!Keyframes.Contains(Time)) FrameIndex.Add(Time);
+	MarkKeyframeDirty(Time);
 	FFICFloatKeyframe* KF = &Keyframes.FindOrAdd(Time);
 	*KF = Keyframe;
 	OnUpdateBroadcast();
@@ -133,43 +101,77 @@ FFICFloatKeyframe* FFICFloatAttribute::SetKeyframe(FICFrame Time, FFICFloatKeyfr
 }
 
 float FFICFloatAttribute::GetValue(FICFrameFloat Time) {
-	FICFrameFloat Time1 = TNumericLimits<FICFrameFloat>::Lowest();
-	FFICFloatKeyframe KF1;
-	FICFrameFloat Time2 = TNumericLimits<FICFrameFloat>::Max();
-	FFICFloatKeyframe KF2;
-	for (const TPair<FICFrame, FFICFloatKeyframe>& Keyframe : Keyframes) {
-		if (Keyframe.Key <= Time) {
-			if (Time1 < Keyframe.Key) {
-				Time1 = Keyframe.Key;
-				KF1 = Keyframe.Value;
-			}
-		} else if (Keyframe.Key > Time) {
-			if (Time2 > Keyframe.Key) {
-				Time2 = Keyframe.Key;
-				KF2 = Keyframe.Value;
-			}
-		}
+	const TArray<FICFrame>& Frames = FrameIndex.Get(Keyframes);
+	if (Frames.Num() < 1) return FallBackValue;
+
+	int32 Next = FFICCurveMath::FindSegment(Frames, Time, SegmentCursor);
+	if (Next < 1) return Keyframes[Frames[0]].Value;
+	if (Next >= Frames.Num()) return Keyframes[Frames.Last()].Value;
+	
+	const FFICFloatKeyframe& KF1 = Keyframes[Frames[Next-1]];
+	const FFICFloatKeyframe& KF2 = Keyframes[Frames[Next]];
+	return FFICCurveMath::EvaluateSegment(ToCurveInterpolation(KF1.KeyframeType), (FICFrameFloat)Frames[Next-1], KF1.Value, KF1.OutTanTime, KF1.OutTanValue, (FICFrameFloat)Frames[Next], KF2.Value, KF2.InTanTime, KF2.InTanValue, Time);
+}
+
+EFICCurveInterpolation FFICFloatAttribute::ToCurveInterpolation(EFICKeyframeType Type) {
+	switch (Type) {
+	case FIC_KF_STEP: return EFICCurveInterpolation::Step;
+	case FIC_KF_LINEAR: return EFICCurveInterpolation::Linear;
+	default: return EFICCurveInterpolation::Bezier;
 	}
+}
 
-	float Interpolated = FallBackValue;
-	if (Time1 > TNumericLimits<float>::Lowest()) {
-		if (Time2 < TNumericLimits<float>::Max()) {
-			float Factor = (Time - Time1) / (Time2 - Time1);
-			if (KF1.KeyframeType == FIC_KF_STEP) {
-				Interpolated = KF1.Value;
-			} else if (KF1.KeyframeType == FIC_KF_LINEAR) {
-				Interpolated = FMath::Lerp(KF1.Value, KF2.Value, Factor);
-			} else {
-				Interpolated = UFICUtils::BezierInterpolate({Time1, KF1.Value}, {Time1 + KF1.OutTanTime, KF1.Value + KF1.OutTanValue},
-                 {Time2 - KF2.InTanTime, KF2.Value - KF2.InTanValue}, {Time2, KF2.Value}, Time);
-			}
-		} else {
-			return KF1.Value;
+FFICCurveKey FFICFloatAttribute::ToCurveKey(const FFICFloatKeyframe& Keyframe) {
+	FFICCurveKey Key(Keyframe.Value, ToCurveInterpolation(Keyframe.KeyframeType));
+	switch (Keyframe.KeyframeType) {
+	case FIC_KF_EASE: Key.TangentMode = EFICCurveTangentMode::Auto; break;
+	case FIC_KF_EASEINOUT: Key.TangentMode = EFICCurveTangentMode::Flat; break;
+	default: Key.TangentMode = EFICCurveTangentMode::User;
+	}
+	Key.InTanTime = Keyframe.InTanTime;
+	Key.InTanValue = Keyframe.InTanValue;
+	Key.OutTanTime = Keyframe.OutTanTime;
+	Key.OutTanValue = Keyframe.OutTanValue;
+	return Key;
+}
+
+void FFICFloatAttribute::SerializeKeyframes(FArchive& Ar) {
+	TArray<FICFrame> Frames;
+	if (Ar.IsSaving()) Frames = FrameIndex.Get(Keyframes);
+	FFICEncoding::SerializeFrames(Ar, Frames);
+	if (Ar.IsError()) return;
+
+	// lower 3 bits keyframe type, 4th bit set if the keyframe has tangents
+	TArray<uint8> Flags;
+	if (Ar.IsSaving()) {
+		Flags.Reserve(Frames.Num());
+		for (FICFrame Frame : Frames) {
+			const FFICFloatKeyframe& Keyframe = Keyframes[Frame];
+			bool bHasTangents = Keyframe.InTanValue != 0.0f || Keyframe.InTanTime != 0.0f || Keyframe.OutTanValue != 0.0f || Keyframe.OutTanTime != 0.0f;
+			Flags.Add(FFICSceneArchive::KeyframeTypeToIndex(Keyframe.KeyframeType) | (bHasTangents ? 0x8 : 0));
 		}
-	} else {
-		if (Time2 < TNumericLimits<float>::Max()) {
-			return KF2.Value;
+	}
+	FFICEncoding::SerializeNibbles(Ar, Flags, Frames.Num());
+
+	TMap<int64, FFICFloatKeyframe> LoadedKeyframes;
+	if (Ar.IsLoading()) LoadedKeyframes.Reserve(Frames.Num());
+	for (int32 i = 0; i < Frames.Num() && !Ar.IsError(); ++i) {
+		FFICFloatKeyframe& Keyframe = Ar.IsSaving() ? Keyframes[Frames[i]] : LoadedKeyframes.Add(Frames[i]);
+		Ar << Keyframe.Value;
+		if (Flags[i] & 0x8) {
+			Ar << Keyframe.InTanValue;
+			Ar << Keyframe.InTanTime;
+			Ar << Keyframe.OutTanValue;
+			Ar << Keyframe.OutTanTime;
 		}
+		if (Ar.IsLoading()) Keyframe.KeyframeType = FFICSceneArchive::IndexToKeyframeType(Flags[i]);
 	}
-	return Interpolated;
-}
\ No newline at end of file
+
+	if (Ar.IsLoading() && !Ar.IsError()) {
+		Keyframes = MoveTemp(LoadedKeyframes);
+		FrameIndex.Invalidate();
+		SegmentCursor = 0;
+		DirtyKeyframes.Empty();
+		MarkChanged();
+	}
+}
@@ -56,6 +56,20 @@ void FFICGroupAttribute::RecalculateKeyframe(FICFrame Time) {
 	}
 }
 
+void FFICGroupAttribute::MarkKeyframeDirty(FICFrame Time) {
+	for (const TPair<FString, FFICAttribute*>& Attr : Children) {
+		Attr.Value->MarkKeyframeDirty(Time);
+	}
+}
+
+void FFICGroupAttribute::RecalculateDirtyKeyframes() {
+	LockUpdateEvent();
+	for (const TPair<FString, FFICAttribute*>& Attr : Children) {
+		Attr.Value->RecalculateDirtyKeyframes();
+	}
+	UnlockUpdateEvent();
+}
+
 void FFICGroupAttribute::Set(TSharedRef<FFICAttribute> InAttrib) {
 	TSharedRef<FFICGroupAttribute> Attrib = StaticCastSharedRef<FFICGroupAttribute>(InAttrib);
 	for (const TPair<FString, FFICAttribute*>& Attr : Children) {
@@ -76,6 +90,14 @@ TSharedRef<FFICEditorAttributeBase> FFICGroupAttribute::CreateEditorAttribute()
 	return MakeShared<FFICEditorAttributeGroup>(*this);
 }
 
+SIZE_T FFICGroupAttribute::GetAllocatedSize() const {
+	SIZE_T Size = sizeof(FFICGroupAttribute) + AttributeCache.GetAllocatedSize() + Children.GetAllocatedSize() + UpdateDelegateHandles.GetAllocatedSize();
+	for (const TPair<FString, TSharedRef<FFICAttribute>>& Attr : AttributeCache) {
+		Size += Attr.Value->GetAllocatedSize();
+	}
+	return Size;
+}
+
 void FFICGroupAttribute::AddChildAttribute(FString Name, FFICAttribute* Attribute) {
 	Children.Add(Name, Attribute);
 	UpdateDelegateHandles.Add(Name, Attribute->OnUpdate.AddLambda([this]() {
@@ -1,9 +1,12 @@
 #include "Data/Attributes/FICAttributeRotation.h"
 
+#include "Algo/BinarySearch.h"
+#include "Algo/Unique.h"
 #include "Editor/FICEditorContext.h"
 #include "Editor/Data/FICEditorAttributeGroup.h"
 #include "Editor/UI/FICKeyframeControl.h"
 #include "Editor/UI/FICVectorEditor.h"
+#include "Widgets/Input/SCheckBox.h"
 
 TSharedRef<FFICEditorAttributeBase> FFICAttributeRotation::CreateEditorAttribute() {
 	TSharedRef<FFICEditorAttributeBase> Base = Super::CreateEditorAttribute();
@@ -28,11 +31,110 @@ TSharedRef<FFICEditorAttributeBase> FFICAttributeRotation::CreateEditorAttribute
 			.Frame_Lambda([Context]() {
 				return Context->GetCurrentFrame();
 			})
+		]
+		+SHorizontalBox::Slot().Padding(5).AutoWidth()[
+			SNew(SCheckBox)
+			.Content()[SNew(STextBlock).Text(FText::FromString("Quaternion"))]
+			.ToolTipText(FText::FromString("Interpolates the rotation as a whole instead of pitch, yaw and roll independently.\nKeyframe spans turning a channel by more than half a turn get split, so multi-turn spins are kept."))
+			.IsChecked_Lambda([Base]() {
+				FFICAttributeRotation& Rotation = static_cast<FFICAttributeRotation&>(Base->GetAttribute());
+				return Rotation.bQuaternionInterpolation ? ECheckBoxState::Checked : ECheckBoxState::Unchecked;
+			})
+			.OnCheckStateChanged_Lambda([Base](ECheckBoxState State) {
+				FFICAttributeRotation& Rotation = static_cast<FFICAttributeRotation&>(Base->GetAttribute());
+				Rotation.bQuaternionInterpolation = State == ECheckBoxState::Checked;
+				Rotation.OnUpdateBroadcast();
+			})
 		];
 	});
 	return Base;
 }
 
+void FFICAttributeRotation::UpdateQuatKeys() {
+	FFICFloatAttribute* Channels[3] = {&Pitch, &Yaw, &Roll};
+	if (QuatKeys.bValid && QuatKeys.Revisions[0] == Pitch.GetRevision() && QuatKeys.Revisions[1] == Yaw.GetRevision() && QuatKeys.Revisions[2] == Roll.GetRevision()) return;
+
+	TArray<FICFrame> ChannelFrames;
+	for (FFICFloatAttribute* Channel : Channels) ChannelFrames.Append(Channel->GetFrames());
+	ChannelFrames.Sort();
+	ChannelFrames.SetNum(Algo::Unique(ChannelFrames));
+
+	QuatKeys.Frames.Reset();
+	QuatKeys.Keys.Reset();
+	QuatKeys.Types.Reset();
+	auto AddKey = [this](FICFrameFloat Frame, EFICKeyframeType Type) {
+		FQuat Key = FRotator(Pitch.GetValue(Frame), Yaw.GetValue(Frame), Roll.GetValue(Frame)).Quaternion();
+		// keep neighbouring keys in the same hemisphere so the shortest path gets interpolated
+		if (QuatKeys.Keys.Num() > 0 && (QuatKeys.Keys.Last() | Key) < 0.0f) Key = Key * -1.0f;
+		QuatKeys.Frames.Add(Frame);
+		QuatKeys.Keys.Add(Key);
+		QuatKeys.Types.Add(Type);
+	};
+	for (int32 i = 0; i < ChannelFrames.Num(); ++i) {
+		EFICKeyframeType Type = FIC_KF_EASE;
+		for (FFICFloatAttribute* Channel : Channels) {
+			FFICFloatKeyframe* Keyframe = Channel->GetKeyframe(ChannelFrames[i]);
+			if (Keyframe) {
+				Type = Keyframe->KeyframeType;
+				break;
+			}
+		}
+
+		if (i > 0 && QuatKeys.Types.Last() != FIC_KF_STEP) {
+			// the shortest path would drop every half turn of a span, so spans turning further get split into intermediate keys taken from the channels
+			FICFrame Start = ChannelFrames[i-1];
+			FICFrame End = ChannelFrames[i];
+			float MaxDelta = 0.0f;
+			for (FFICFloatAttribute* Channel : Channels) MaxDelta = FMath::Max(MaxDelta, FMath::Abs(Channel->GetValue(End) - Channel->GetValue(Start)));
+			int32 Segments = FMath::FloorToInt(MaxDelta / 180.0f) + 1;
+			EFICKeyframeType SegmentType = QuatKeys.Types.Last();
+			for (int32 Segment = 1; Segment < Segments; ++Segment) {
+				AddKey(Start + (FICFrameFloat)(End - Start) * Segment / Segments, SegmentType);
+			}
+		}
+		
+		AddKey(ChannelFrames[i], Type);
+	}
+
+	const TArray<FICFrameFloat>& Frames = QuatKeys.Frames;
+	QuatKeys.Tangents.SetNumUninitialized(Frames.Num());
+	for (int32 i = 0; i < Frames.Num(); ++i) {
+		const FQuat& Prev = QuatKeys.Keys[FMath::Max(i-1, 0)];
+		const FQuat& Next = QuatKeys.Keys[FMath::Min(i+1, Frames.Num()-1)];
+		FQuat::CalcTangents(Prev, QuatKeys.Keys[i], Next, 0.0f, QuatKeys.Tangents[i]);
+	}
+
+	for (int32 i = 0; i < 3; ++i) QuatKeys.Revisions[i] = Channels[i]->GetRevision();
+	QuatKeys.SegmentCursor = 0;
+	QuatKeys.bValid = true;
+}
+
+FQuat FFICAttributeRotation::GetQuat(FICFrameFloat Frame) {
+	UpdateQuatKeys();
+	const TArray<FICFrameFloat>& Frames = QuatKeys.Frames;
+	if (Frames.Num() < 1) return FRotator(Pitch.GetValue(Frame), Yaw.GetValue(Frame), Roll.GetValue(Frame)).Quaternion();
+
+	// index of the first key after the given frame, the last segment gets reused as long as the frame stays within it
+	int32 Next = QuatKeys.SegmentCursor;
+	if (!Frames.IsValidIndex(Next) || Frames[Next] <= Frame || (Next > 0 && Frames[Next-1] > Frame)) {
+		Next = Algo::UpperBound(Frames, Frame);
+		QuatKeys.SegmentCursor = Next;
+	}
+	if (Next < 1) return QuatKeys.Keys[0];
+	if (Next >= Frames.Num()) return QuatKeys.Keys.Last();
+
+	int32 Prev = Next - 1;
+	float Alpha = (Frame - Frames[Prev]) / (Frames[Next] - Frames[Prev]);
+	switch (QuatKeys.Types[Prev]) {
+	case FIC_KF_STEP:
+		return QuatKeys.Keys[Prev];
+	case FIC_KF_LINEAR:
+		return FQuat::Slerp(QuatKeys.Keys[Prev], QuatKeys.Keys[Next], Alpha);
+	default:
+		return FQuat::Squad(QuatKeys.Keys[Prev], QuatKeys.Tangents[Prev], QuatKeys.Keys[Next], QuatKeys.Tangents[Next], Alpha);
+	}
+}
+
 FRotator FFICAttributeRotation::FromEditorAttribute(FFICEditorAttributeGroup& Attribute) {
 	return FRotator(
 		Attribute.Get<TFICEditorAttribute<FFICFloatAttribute>>("Pitch").GetValue(),
@@ -41,6 +143,15 @@ FRotator FFICAttributeRotation::FromEditorAttribute(FFICEditorAttributeGroup& At
 	);
 }
 
+FRotator FFICAttributeRotation::FromEditorAttribute(FFICEditorAttributeGroup& Attribute, FICFrame Time) {
+	FFICAttribute& Attrib = Attribute.GetAttribute();
+	if (Attrib.GetAttributeType() == TypeName) {
+		FFICAttributeRotation& Rotation = static_cast<FFICAttributeRotation&>(Attrib);
+		if (Rotation.bQuaternionInterpolation && !Attribute.HasChanged(Time)) return Rotation.Get(Time);
+	}
+	return FromEditorAttribute(Attribute);
+}
+
 void FFICAttributeRotation::ToEditorAttribute(const FRotator& Rotator, FFICEditorAttributeGroup& Attribute) {
 	Attribute.Get<TFICEditorAttribute<FFICFloatAttribute>>("Pitch").SetValue(Rotator.Pitch);
 	Attribute.Get<TFICEditorAttribute<FFICFloatAttribute>>("Yaw").SetValue(Rotator.Yaw);
@@ -1,37 +1,99 @@
 #include "Data/FICActiveSceneObjectManager.h"
 
+#include "FICStats.h"
+
+DECLARE_CYCLE_STAT(TEXT("Active Scene Objects Update"), STAT_FICActiveSceneObjectsUpdate, STATGROUP_FicsItCam);
+DECLARE_CYCLE_STAT(TEXT("Active Scene Objects Rebuild"), STAT_FICActiveSceneObjectsRebuild, STATGROUP_FicsItCam);
+
 void FFICActiveSceneObjectManager::Initialize(AFICScene* InScene) {
 	Scene = InScene;
+	Invalidate();
 }
 
-void FFICActiveSceneObjectManager::UpdateActiveObjects(FICFrameFloat Frame) {
-	TMap<FString, UObject*> Active;
-	if (Scene) for (UObject* SceneObject : Scene->GetSceneObjects()) {
+void FFICActiveSceneObjectManager::BuildCandidates() {
+	SCOPE_CYCLE_COUNTER(STAT_FICActiveSceneObjectsRebuild);
+	Invalidate();
+	if (!Scene) return;
+	
+	for (UObject* SceneObject : Scene->GetSceneObjects()) {
 		IFICSceneObjectActive* SceneObjectActive = Cast<IFICSceneObjectActive>(SceneObject);
 		if (!SceneObjectActive) continue;
-		FString Type = SceneObjectActive->GetActiveType();
-		if (!Active.Contains(Type) && IsSceneObjectActive.Execute(SceneObject, Frame)) {
-			Active.Add(Type, SceneObject);
-			UObject** CurrentActive = ActiveSceneObjects.Find(Type);
-			if (!CurrentActive) {
-				SceneObjectActive->Activate();
-			} else if (*CurrentActive != SceneObject) {
-				Cast<IFICSceneObjectActive>(*CurrentActive)->Deactivate();
-				SceneObjectActive->Activate();
-			}
+		Candidates.FindOrAdd(SceneObjectActive->GetActiveType()).Add(SceneObject);
+		FFICAttribute* Attribute = &SceneObjectActive->GetActiveAttribute();
+		UpdateDelegateHandles.Add(TPair<FFICAttribute*, FDelegateHandle>(Attribute, Attribute->OnUpdate.AddLambda([this]() {
+			bTimelinesValid = false;
+		})));
+	}
+
+	// scene objects that are not candidates anymore can't stay active
+	for (TMap<FString, UObject*>::TIterator It = ActiveSceneObjects.CreateIterator(); It; ++It) {
+		TArray<UObject*>* TypeCandidates = Candidates.Find(It->Key);
+		if (!TypeCandidates || !TypeCandidates->Contains(It->Value)) {
+			Cast<IFICSceneObjectActive>(It->Value)->Deactivate();
+			It.RemoveCurrent();
+		}
+	}
+	
+	bCandidatesValid = true;
+}
+
+void FFICActiveSceneObjectManager::UpdateActiveObjects(FICFrameFloat Frame) {
+	SCOPE_CYCLE_COUNTER(STAT_FICActiveSceneObjectsUpdate);
+	
+	// not initialized or already shut down, rebuilding the candidates would register delegates nobody removes
+	if (!Scene) return;
+	
+	if (!bCandidatesValid) BuildCandidates();
+	bool bUseTimelines = !IsSceneObjectActive.IsBound();
+	if (bUseTimelines && !bTimelinesValid) {
+		SCOPE_CYCLE_COUNTER(STAT_FICActiveSceneObjectsRebuild);
+		for (const TPair<FString, TArray<UObject*>>& Type : Candidates) {
+			Timelines.FindOrAdd(Type.Key).Build(Type.Value);
 		}
+		bTimelinesValid = true;
 	}
-	for (const TPair<FString, UObject*>& ActiveSceneObject : ActiveSceneObjects) {
-		if (!Active.Contains(ActiveSceneObject.Key)) {
-			Cast<IFICSceneObjectActive>(ActiveSceneObject.Value)->Deactivate();
+	
+	for (const TPair<FString, TArray<UObject*>>& Type : Candidates) {
+		UObject* NewActive = nullptr;
+		if (bUseTimelines) {
+			NewActive = Timelines[Type.Key].Resolve(Frame);
+		} else for (UObject* Candidate : Type.Value) {
+			if (IsSceneObjectActive.Execute(Candidate, Frame)) {
+				NewActive = Candidate;
+				break;
+			}
+		}
+		
+		UObject** CurrentActivePtr = ActiveSceneObjects.Find(Type.Key);
+		UObject* CurrentActive = CurrentActivePtr ? *CurrentActivePtr : nullptr;
+		if (CurrentActive == NewActive) continue;
+		if (CurrentActive) Cast<IFICSceneObjectActive>(CurrentActive)->Deactivate();
+		if (NewActive) {
+			Cast<IFICSceneObjectActive>(NewActive)->Activate();
+			ActiveSceneObjects.Add(Type.Key, NewActive);
+		} else {
+			ActiveSceneObjects.Remove(Type.Key);
 		}
 	}
-	ActiveSceneObjects = Active;
 }
 
 void FFICActiveSceneObjectManager::Shutdown() {
+	Invalidate();
 	for (const TPair<FString, UObject*>& Object : ActiveSceneObjects) {
 		Cast<IFICSceneObjectActive>(Object.Value)->Deactivate();
 	}
 	ActiveSceneObjects.Empty();
+	IsSceneObjectActive.Unbind();
+	Scene = nullptr;
+}
+
+void FFICActiveSceneObjectManager::Invalidate() {
+	for (const TPair<FFICAttribute*, FDelegateHandle>& Handle : UpdateDelegateHandles) {
+		Handle.Key->OnUpdate.Remove(Handle.Value);
+	}
+	UpdateDelegateHandles.Empty();
+	Candidates.Empty();
+	Timelines.Empty();
+	bCandidatesValid = false;
+	bTimelinesValid = false;
 }
@@ -0,0 +1,37 @@
+#include "Data/FICActiveTimeline.h"
+
+#include "Algo/BinarySearch.h"
+#include "Data/Objects/FICSceneObjectActive.h"
+
+void FFICActiveTimeline::Build(const TArray<UObject*>& Candidates) {
+	TSet<FICFrame> Frames;
+	for (UObject* Candidate : Candidates) {
+		TArray<FICFrame> Keys;
+		Cast<IFICSceneObjectActive>(Candidate)->GetActiveAttribute().GetKeyframes().GetKeys(Keys);
+		Frames.Append(Keys);
+	}
+	Breakpoints = Frames.Array();
+	Breakpoints.Sort();
+
+	auto FindActive = [&Candidates](FICFrame Frame) -> UObject* {
+		for (UObject* Candidate : Candidates) {
+			if (Cast<IFICSceneObjectActive>(Candidate)->GetActiveAttribute().GetValue(Frame)) return Candidate;
+		}
+		return nullptr;
+	};
+	
+	Segments.Empty(Breakpoints.Num() + 1);
+	Segments.Add(FindActive(Breakpoints.Num() > 0 ? Breakpoints[0] - 1 : 0));
+	TArray<FICFrame> Transitions;
+	for (FICFrame Breakpoint : Breakpoints) {
+		UObject* Active = FindActive(Breakpoint);
+		if (Active == Segments.Last()) continue;
+		Transitions.Add(Breakpoint);
+		Segments.Add(Active);
+	}
+	Breakpoints = MoveTemp(Transitions);
+}
+
+UObject* FFICActiveTimeline::Resolve(FICFrameFloat Frame) const {
+	return Segments[Algo::UpperBound(Breakpoints, Frame)];
+}
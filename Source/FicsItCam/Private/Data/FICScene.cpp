@@ -1,25 +1,178 @@
 #include "Data/FICScene.h"
 
+#include "FICSubsystem.h"
 #include "FICUtils.h"
+#include "Data/FICSceneArchive.h"
+
+void AFICScene::PreSaveGame_Implementation(int32 saveVersion, int32 gameVersion) {
+	IFGSaveInterface::PreSaveGame_Implementation(saveVersion, gameVersion);
+
+	// the scene objects get serialized after all objects got prepared, so their keyframes only end up in the scene data
+	FFICSceneArchive::Save(this, SceneData);
+	for (UObject* SceneObject : SceneObjects) {
+		FFICSceneArchive::ForEachLeafAttribute(Cast<IFICSceneObject>(SceneObject)->GetRootAttribute(), [](const FString&, FFICAttribute& Attribute) {
+			Attribute.StashKeyframes();
+		});
+	}
+}
+
+void AFICScene::PostSaveGame_Implementation(int32 saveVersion, int32 gameVersion) {
+	IFGSaveInterface::PostSaveGame_Implementation(saveVersion, gameVersion);
+
+	for (UObject* SceneObject : SceneObjects) {
+		FFICSceneArchive::ForEachLeafAttribute(Cast<IFICSceneObject>(SceneObject)->GetRootAttribute(), [](const FString&, FFICAttribute& Attribute) {
+			Attribute.UnstashKeyframes();
+		});
+	}
+	SceneData.Empty();
+}
 
 void AFICScene::PostLoadGame_Implementation(int32 saveVersion, int32 gameVersion) {
 	IFGSaveInterface::PostLoadGame_Implementation(saveVersion, gameVersion);
 
 	SceneObjects.Remove(nullptr);
+
+	// saves of older versions have no scene data, the keyframes got loaded with the attributes instead
+	if (SceneData.Num() > 0) {
+		FFICSceneArchive::Load(this, SceneData);
+		SceneData.Empty();
+	}
+	InvalidateCameraTimeline();
+	bSceneObjectIndexValid = false;
+
+	if (AFICSubsystem* SubSys = AFICSubsystem::GetFICSubsystem(this)) SubSys->RegisterScene(this);
+}
+
+void AFICScene::BeginPlay() {
+	Super::BeginPlay();
+
+	if (AFICSubsystem* SubSys = AFICSubsystem::GetFICSubsystem(this)) SubSys->RegisterScene(this);
+}
+
+void AFICScene::EndPlay(const EEndPlayReason::Type EndPlayReason) {
+	Super::EndPlay(EndPlayReason);
+
+	InvalidateCameraTimeline();
+	if (AFICSubsystem* SubSys = AFICSubsystem::GetFICSubsystem(this)) SubSys->UnregisterScene(this);
+}
+
+void AFICScene::AddSceneObject(UObject* Object) {
+	check(Object->Implements<UFICSceneObject>());
+	SceneObjects.Add(Object);
+	InvalidateCameraTimeline();
+	if (bSceneObjectIndexValid) SceneObjectIndex.FindOrAdd(Cast<IFICSceneObject>(Object)->GetSceneObjectName(), Object);
+	if (AFICSubsystem* SubSys = AFICSubsystem::GetFICSubsystem(this)) SubSys->InvalidateReferences();
+}
+
+void AFICScene::RemoveSceneObject(UObject* Object) {
+	InvalidateCameraTimeline();
+	SceneObjects.Remove(Object);
+	FString Name = Cast<IFICSceneObject>(Object)->GetSceneObjectName();
+	if (bSceneObjectIndexValid) {
+		UObject** Indexed = SceneObjectIndex.Find(Name);
+		if (Indexed && *Indexed == Object) SceneObjectIndex.Remove(Name);
+	}
+	ReleaseSceneObjectName(Name);
+	if (AFICSubsystem* SubSys = AFICSubsystem::GetFICSubsystem(this)) SubSys->InvalidateReferences();
 }
 
 void AFICScene::MoveSceneObject(UObject* Object, int Delta) {
 	int Index = SceneObjects.Find(Object);
 	SceneObjects.RemoveAt(Index);
 	SceneObjects.Insert(Object, UFICUtils::Modulo(Index + Delta, SceneObjects.Num()+1));
+	InvalidateCameraTimeline();
 }
 
 UFICCamera* AFICScene::GetActiveCamera(FICFrameFloat Time) {
-	for (UObject* SceneObject : GetSceneObjects()) {
+	UpdateCameraTimeline();
+	return Cast<UFICCamera>(CameraTimeline.Resolve(Time));
+}
+
+FFICActiveTimeline::FCutIterator AFICScene::CreateCameraCutIterator() {
+	UpdateCameraTimeline();
+	return CameraTimeline.CreateCutIterator();
+}
+
+void AFICScene::SetSceneName(const FString& InSceneName) {
+	FString OldSceneName = SceneName;
+	SceneName = InSceneName;
+	if (AFICSubsystem* SubSys = AFICSubsystem::GetFICSubsystem(this)) SubSys->OnSceneRenamed(this, OldSceneName);
+}
+
+UObject* AFICScene::FindSceneObject(const FString& InSceneObjectName) {
+	if (!bSceneObjectIndexValid) BuildSceneObjectIndex();
+	UObject** Object = SceneObjectIndex.Find(InSceneObjectName);
+	if (Object && Cast<IFICSceneObject>(*Object)->GetSceneObjectName() != InSceneObjectName) {
+		// the scene object got renamed without RenameSceneObject
+		BuildSceneObjectIndex();
+		Object = SceneObjectIndex.Find(InSceneObjectName);
+	}
+	return Object ? *Object : nullptr;
+}
+
+void AFICScene::RenameSceneObject(UObject* Object, const FString& InSceneObjectName) {
+	IFICSceneObject* SceneObject = Cast<IFICSceneObject>(Object);
+	FString OldName = SceneObject->GetSceneObjectName();
+	SceneObject->SetSceneObjectName(InSceneObjectName);
+	if (AFICSubsystem* SubSys = AFICSubsystem::GetFICSubsystem(this)) SubSys->InvalidateReferences();
+	ReleaseSceneObjectName(OldName);
+	if (!bSceneObjectIndexValid) return;
+	UObject** Indexed = SceneObjectIndex.Find(OldName);
+	if (Indexed && *Indexed == Object) SceneObjectIndex.Remove(OldName);
+	SceneObjectIndex.FindOrAdd(InSceneObjectName, Object);
+}
+
+FString AFICScene::MakeUniqueSceneObjectName(const FString& InBaseName) {
+	if (!FindSceneObject(InBaseName)) return InBaseName;
+	int32& Suffix = NextNameSuffix.FindOrAdd(InBaseName, 1);
+	FString Name;
+	do {
+		Name = FString::Printf(TEXT("%s_%i"), *InBaseName, Suffix++);
+	} while (FindSceneObject(Name));
+	return Name;
+}
+
+void AFICScene::ReleaseSceneObjectName(const FString& InName) {
+	int32 Separator;
+	if (!InName.FindLastChar(TEXT('_'), Separator)) return;
+	FString SuffixString = InName.RightChop(Separator + 1);
+	if (SuffixString.IsEmpty()) return;
+	for (TCHAR Char : SuffixString) if (!FChar::IsDigit(Char)) return;
+	int32* NextSuffix = NextNameSuffix.Find(InName.Left(Separator));
+	int32 Suffix = FCString::Atoi(*SuffixString);
+	// the next unique name reuses the lowest freed suffix, used suffixes above it get skipped by the search
+	if (NextSuffix && Suffix >= 1 && Suffix < *NextSuffix) *NextSuffix = Suffix;
+}
+
+void AFICScene::BuildSceneObjectIndex() {
+	SceneObjectIndex.Empty(SceneObjects.Num());
+	for (UObject* Object : SceneObjects) {
+		SceneObjectIndex.FindOrAdd(Cast<IFICSceneObject>(Object)->GetSceneObjectName(), Object);
+	}
+	bSceneObjectIndexValid = true;
+}
+
+void AFICScene::InvalidateCameraTimeline() {
+	for (const TPair<FFICAttribute*, FDelegateHandle>& Handle : CameraUpdateDelegateHandles) {
+		Handle.Key->OnUpdate.Remove(Handle.Value);
+	}
+	CameraUpdateDelegateHandles.Empty();
+	bCameraTimelineValid = false;
+}
+
+void AFICScene::UpdateCameraTimeline() {
+	if (bCameraTimelineValid) return;
+	InvalidateCameraTimeline();
+	
+	TArray<UObject*> Cameras;
+	for (UObject* SceneObject : SceneObjects) {
 		UFICCamera* Camera = Cast<UFICCamera>(SceneObject);
-		if (Camera) {
-			if (Camera->Active.GetValue(Time)) return Camera;
-		}
+		if (!Camera) continue;
+		Cameras.Add(Camera);
+		CameraUpdateDelegateHandles.Add(TPair<FFICAttribute*, FDelegateHandle>(&Camera->Active, Camera->Active.OnUpdate.AddWeakLambda(this, [this]() {
+			bCameraTimelineValid = false;
+		})));
 	}
-	return nullptr;
+	CameraTimeline.Build(Cameras);
+	bCameraTimelineValid = true;
 }
@@ -0,0 +1,174 @@
+#include "Data/FICSceneArchive.h"
+
+#include "FICStats.h"
+#include "FicsItCamModule.h"
+#include "Data/FICScene.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+DECLARE_CYCLE_STAT(TEXT("Scene Archive Save"), STAT_FICSceneArchiveSave, STATGROUP_FicsItCam);
+DECLARE_CYCLE_STAT(TEXT("Scene Archive Load"), STAT_FICSceneArchiveLoad, STATGROUP_FicsItCam);
+
+static const EFICKeyframeType KeyframeTypes[] = {
+	FIC_KF_NONE,
+	FIC_KF_HANDLES,
+	FIC_KF_EASE,
+	FIC_KF_EASEINOUT,
+	FIC_KF_MIRROR,
+	FIC_KF_CUSTOM,
+	FIC_KF_LINEAR,
+	FIC_KF_STEP,
+};
+
+void FFICSceneArchive::Save(AFICScene* Scene, TArray<uint8>& OutData) {
+	SCOPE_CYCLE_COUNTER(STAT_FICSceneArchiveSave);
+	
+	OutData.Reset();
+	FMemoryWriter Ar(OutData);
+
+	uint32 MagicValue = Magic;
+	uint32 Version = VERSION_LATEST;
+	Ar << MagicValue;
+	Ar << Version;
+
+	TArray<UObject*> SceneObjects = Scene->GetSceneObjects();
+	uint64 NumObjects = SceneObjects.Num();
+	FFICEncoding::SerializeVarInt(Ar, NumObjects);
+	for (UObject* Object : SceneObjects) {
+		IFICSceneObject* SceneObject = Cast<IFICSceneObject>(Object);
+		FString Name = SceneObject->GetSceneObjectName();
+		Ar << Name;
+		SaveSceneObjectKeyframes(Ar, SceneObject);
+	}
+}
+
+bool FFICSceneArchive::Load(AFICScene* Scene, const TArray<uint8>& Data) {
+	SCOPE_CYCLE_COUNTER(STAT_FICSceneArchiveLoad);
+	
+	FMemoryReader Ar(Data);
+
+	uint32 MagicValue = 0;
+	uint32 Version = 0;
+	Ar << MagicValue;
+	Ar << Version;
+	if (Ar.IsError() || MagicValue != Magic || Version > VERSION_LATEST) {
+		UE_LOG(LogFicsItCam, Warning, TEXT("Unable to read scene data of scene '%s' (version %u), keeping reflected keyframes"), *Scene->SceneName, Version);
+		return false;
+	}
+
+	// blocks are written in scene object order, names are not unique so they only verify the object at that index
+	TArray<UObject*> SceneObjects = Scene->GetSceneObjects();
+	TBitArray<> Loaded(false, SceneObjects.Num());
+	uint64 NumObjects = 0;
+	FFICEncoding::SerializeVarInt(Ar, NumObjects);
+	for (uint64 i = 0; i < NumObjects && !Ar.IsError(); ++i) {
+		FString Name;
+		Ar << Name;
+		int32 Index = FindSceneObject(SceneObjects, Loaded, Name, i);
+		IFICSceneObject* SceneObject = nullptr;
+		if (Index != INDEX_NONE) {
+			Loaded[Index] = true;
+			SceneObject = Cast<IFICSceneObject>(SceneObjects[Index]);
+		}
+		LoadSceneObjectKeyframes(Ar, SceneObject);
+	}
+
+	if (Ar.IsError()) {
+		UE_LOG(LogFicsItCam, Error, TEXT("Scene data of scene '%s' is corrupted, keyframes might be missing"), *Scene->SceneName);
+	}
+	return !Ar.IsError();
+}
+
+int32 FFICSceneArchive::FindSceneObject(const TArray<UObject*>& SceneObjects, const TBitArray<>& Loaded, const FString& Name, uint64 BlockIndex) {
+	auto Matches = [&](int32 Index) {
+		return !Loaded[Index] && Cast<IFICSceneObject>(SceneObjects[Index])->GetSceneObjectName() == Name;
+	};
+	if (BlockIndex < (uint64)SceneObjects.Num() && Matches((int32)BlockIndex)) return (int32)BlockIndex;
+	// the scene object list changed since the blob got written, fall back to the first unloaded object with the same name
+	for (int32 Index = 0; Index < SceneObjects.Num(); ++Index) {
+		if (Matches(Index)) return Index;
+	}
+	return INDEX_NONE;
+}
+
+void FFICSceneArchive::SaveSceneObjectKeyframes(FArchive& Ar, IFICSceneObject* SceneObject) {
+	TArray<TPair<FString, FFICAttribute*>> Leaves;
+	ForEachLeafAttribute(SceneObject->GetRootAttribute(), [&Leaves](const FString& Path, FFICAttribute& Attribute) {
+		Leaves.Emplace(Path, &Attribute);
+	});
+	uint64 NumLeaves = Leaves.Num();
+	FFICEncoding::SerializeVarInt(Ar, NumLeaves);
+	for (TPair<FString, FFICAttribute*>& Leaf : Leaves) {
+		FString Type = Leaf.Value->GetAttributeType().ToString();
+		Ar << Leaf.Key;
+		Ar << Type;
+
+		// size prefix, patched after the block got written
+		int64 SizePos = Ar.Tell();
+		uint32 BlockSize = 0;
+		Ar << BlockSize;
+		Leaf.Value->SerializeKeyframes(Ar);
+		int64 EndPos = Ar.Tell();
+		BlockSize = EndPos - SizePos - sizeof(uint32);
+		Ar.Seek(SizePos);
+		Ar << BlockSize;
+		Ar.Seek(EndPos);
+	}
+}
+
+void FFICSceneArchive::LoadSceneObjectKeyframes(FArchive& Ar, IFICSceneObject* SceneObject) {
+	TMap<FString, FFICAttribute*> Leaves;
+	if (SceneObject) {
+		ForEachLeafAttribute(SceneObject->GetRootAttribute(), [&Leaves](const FString& Path, FFICAttribute& Attribute) {
+			Leaves.Add(Path, &Attribute);
+		});
+	}
+	
+	uint64 NumLeaves = 0;
+	FFICEncoding::SerializeVarInt(Ar, NumLeaves);
+	for (uint64 i = 0; i < NumLeaves && !Ar.IsError(); ++i) {
+		FString Path;
+		FString Type;
+		uint32 BlockSize = 0;
+		Ar << Path;
+		Ar << Type;
+		Ar << BlockSize;
+		int64 EndPos = Ar.Tell() + BlockSize;
+		if (EndPos > Ar.TotalSize()) {
+			Ar.SetError();
+			return;
+		}
+
+		FFICAttribute** Leaf = Leaves.Find(Path);
+		if (Leaf && (*Leaf)->GetAttributeType().ToString() == Type) {
+			(*Leaf)->SerializeKeyframes(Ar);
+		}
+		if (Ar.Tell() != EndPos) Ar.Seek(EndPos);
+	}
+}
+
+void FFICSceneArchive::ForEachLeafAttribute(FFICAttribute& Root, TFunctionRef<void(const FString& Path, FFICAttribute& Attribute)> Func) {
+	TFunction<void(const FString&, FFICAttribute&)> Visit;
+	Visit = [&Visit, &Func](const FString& Path, FFICAttribute& Attribute) {
+		TMap<FString, FFICAttribute*> Children = Attribute.GetChildAttributes();
+		if (Children.Num() < 1) {
+			Func(Path, Attribute);
+			return;
+		}
+		for (const TPair<FString, FFICAttribute*>& Child : Children) {
+			Visit(Path.Len() > 0 ? Path + TEXT("/") + Child.Key : Child.Key, *Child.Value);
+		}
+	};
+	Visit(FString(), Root);
+}
+
+uint8 FFICSceneArchive::KeyframeTypeToIndex(EFICKeyframeType Type) {
+	for (uint8 i = 0; i < UE_ARRAY_COUNT(KeyframeTypes); ++i) {
+		if (KeyframeTypes[i] == Type) return i;
+	}
+	return KeyframeTypeToIndex(FIC_KF_EASE);
+}
+
+EFICKeyframeType FFICSceneArchive::IndexToKeyframeType(uint8 Index) {
+	return KeyframeTypes[Index & 0x7];
+}
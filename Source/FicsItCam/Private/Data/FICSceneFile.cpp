@@ -0,0 +1,182 @@
+#include "Data/FICSceneFile.h"
+
+#include "FICSubsystem.h"
+#include "Data/FICScene.h"
+#include "FicsItCamModule.h"
+#include "Data/FICSceneArchive.h"
+#include "Serialization/ObjectAndNameAsStringProxyArchive.h"
+
+static bool ReadHeader(FArchive& Ar, FString& OutSceneName, FString& OutError) {
+	uint32 MagicValue = 0;
+	uint32 Version = 0;
+	Ar << MagicValue;
+	Ar << Version;
+	if (Ar.IsError() || MagicValue != FFICSceneFile::Magic) {
+		OutError = TEXT("File is no FicsIt-Cam scene file");
+		return false;
+	}
+	if (Version > FFICSceneFile::VERSION_LATEST) {
+		OutError = FString::Printf(TEXT("Scene file version %u is not supported"), Version);
+		return false;
+	}
+	Ar << OutSceneName;
+	return !Ar.IsError();
+}
+
+static void SerializeSceneSettings(FArchive& Ar, AFICScene* Scene) {
+	Ar << Scene->AnimationRange.Begin;
+	Ar << Scene->AnimationRange.End;
+	Ar << Scene->FPS;
+	Ar << Scene->ResolutionWidth;
+	Ar << Scene->ResolutionHeight;
+	Ar << Scene->SensorDimension;
+	Ar << Scene->bUseCinematic;
+	Ar << Scene->bBulletTime;
+	Ar << Scene->bLooping;
+	Ar << Scene->bMultiCameraRender;
+	Ar << Scene->LastCameraTransform;
+	Ar << Scene->bViewportEverSaved;
+}
+
+static void StashKeyframes(UObject* Object, bool bStash) {
+	FFICSceneArchive::ForEachLeafAttribute(Cast<IFICSceneObject>(Object)->GetRootAttribute(), [bStash](const FString&, FFICAttribute& Attribute) {
+		if (bStash) Attribute.StashKeyframes();
+		else Attribute.UnstashKeyframes();
+	});
+}
+
+FString FFICSceneFile::GetSceneFileDirectory() {
+	return FPaths::Combine(FPlatformProcess::UserSettingsDir(), FApp::GetProjectName(), TEXT("Saved/") TEXT("SaveGames/") TEXT("FicsItCam/"));
+}
+
+bool FFICSceneFile::ResolvePath(const FString& InPath, FString& OutPath, FString& OutError) {
+	// commands can be run by any player, so files may only be written and read within the scene file directory
+	FString Path = InPath.Replace(TEXT("\\"), TEXT("/"));
+	if (Path.IsEmpty() || !FPaths::IsRelative(Path) || Path.StartsWith(TEXT("/")) || Path.Contains(TEXT(":"))) {
+		OutError = FString::Printf(TEXT("'%s' is no path relative to the scene file directory"), *InPath);
+		return false;
+	}
+	TArray<FString> Segments;
+	Path.ParseIntoArray(Segments, TEXT("/"));
+	if (Segments.Contains(TEXT(".."))) {
+		OutError = FString::Printf(TEXT("'%s' may not leave the scene file directory"), *InPath);
+		return false;
+	}
+
+	FString Directory = FPaths::ConvertRelativePathToFull(GetSceneFileDirectory());
+	Path = FPaths::ConvertRelativePathToFull(FPaths::Combine(Directory, Path));
+	if (!FPaths::IsUnderDirectory(Path, Directory)) {
+		OutError = FString::Printf(TEXT("'%s' may not leave the scene file directory"), *InPath);
+		return false;
+	}
+	if (FPaths::GetExtension(Path).Len() < 1) Path += TEXT(".ficscene");
+	OutPath = Path;
+	return true;
+}
+
+bool FFICSceneFile::Export(AFICScene* Scene, const FString& Path, FString& OutError) {
+	IFileManager::Get().MakeDirectory(*FPaths::GetPath(Path), true);
+	TUniquePtr<FArchive> File(IFileManager::Get().CreateFileWriter(*Path));
+	if (!File) {
+		OutError = FString::Printf(TEXT("Unable to open '%s' for writing"), *Path);
+		return false;
+	}
+	FArchive& Ar = *File;
+
+	uint32 MagicValue = Magic;
+	uint32 Version = VERSION_LATEST;
+	FString SceneName = Scene->SceneName;
+	Ar << MagicValue;
+	Ar << Version;
+	Ar << SceneName;
+	SerializeSceneSettings(Ar, Scene);
+
+	TArray<UObject*> SceneObjects = Scene->GetSceneObjects();
+	uint64 NumObjects = SceneObjects.Num();
+	FFICEncoding::SerializeVarInt(Ar, NumObjects);
+	for (UObject* Object : SceneObjects) {
+		FString ClassPath = Object->GetClass()->GetPathName();
+		Ar << ClassPath;
+		
+		// size prefix, patched after the properties got written
+		int64 SizePos = Ar.Tell();
+		uint32 PropertiesSize = 0;
+		Ar << PropertiesSize;
+		{
+			// the keyframes are written separately in their compact format
+			StashKeyframes(Object, true);
+			FObjectAndNameAsStringProxyArchive PropertyAr(Ar, false);
+			PropertyAr.ArIsSaveGame = true;
+			PropertyAr.ArNoDelta = true;
+			Object->GetClass()->SerializeTaggedProperties(PropertyAr, (uint8*)Object, Object->GetClass(), nullptr);
+			StashKeyframes(Object, false);
+		}
+		int64 EndPos = Ar.Tell();
+		PropertiesSize = EndPos - SizePos - sizeof(uint32);
+		Ar.Seek(SizePos);
+		Ar << PropertiesSize;
+		Ar.Seek(EndPos);
+
+		FFICSceneArchive::SaveSceneObjectKeyframes(Ar, Cast<IFICSceneObject>(Object));
+	}
+
+	bool bSuccess = File->Close();
+	if (!bSuccess) OutError = FString::Printf(TEXT("Failed to write '%s'"), *Path);
+	return bSuccess;
+}
+
+AFICScene* FFICSceneFile::Import(UObject* WorldContext, const FString& Path, const FString& SceneName, FString& OutError) {
+	TUniquePtr<FArchive> File(IFileManager::Get().CreateFileReader(*Path));
+	if (!File) {
+		OutError = FString::Printf(TEXT("Unable to open '%s'"), *Path);
+		return nullptr;
+	}
+	FArchive& Ar = *File;
+
+	FString StoredSceneName;
+	if (!ReadHeader(Ar, StoredSceneName, OutError)) return nullptr;
+
+	AFICSubsystem* SubSys = AFICSubsystem::GetFICSubsystem(WorldContext);
+	AFICScene* Scene = WorldContext->GetWorld()->SpawnActor<AFICScene>();
+	SerializeSceneSettings(Ar, Scene);
+	Scene->SetSceneName(SceneName.Len() > 0 ? SceneName : StoredSceneName);
+
+	uint64 NumObjects = 0;
+	FFICEncoding::SerializeVarInt(Ar, NumObjects);
+	for (uint64 i = 0; i < NumObjects && !Ar.IsError(); ++i) {
+		FString ClassPath;
+		uint32 PropertiesSize = 0;
+		Ar << ClassPath;
+		Ar << PropertiesSize;
+		int64 PropertiesEnd = Ar.Tell() + PropertiesSize;
+		
+		UClass* Class = LoadObject<UClass>(nullptr, *ClassPath);
+		UObject* Object = nullptr;
+		if (Class && Class->ImplementsInterface(UFICSceneObject::StaticClass())) {
+			Object = Cast<IFICSceneObject>(Class->GetDefaultObject())->CreateNewObject(SubSys, Scene);
+			FObjectAndNameAsStringProxyArchive PropertyAr(Ar, true);
+			PropertyAr.ArIsSaveGame = true;
+			PropertyAr.ArNoDelta = true;
+			Class->SerializeTaggedProperties(PropertyAr, (uint8*)Object, Class, nullptr);
+		} else {
+			UE_LOG(LogFicsItCam, Warning, TEXT("Skipping scene object of unknown class '%s' in scene file '%s'"), *ClassPath, *Path);
+		}
+		if (Ar.Tell() != PropertiesEnd) Ar.Seek(PropertiesEnd);
+
+		FFICSceneArchive::LoadSceneObjectKeyframes(Ar, Object ? Cast<IFICSceneObject>(Object) : nullptr);
+		if (Object) Scene->AddSceneObject(Object);
+	}
+
+	if (Ar.IsError()) {
+		OutError = FString::Printf(TEXT("Scene file '%s' is corrupted"), *Path);
+		Scene->Destroy();
+		return nullptr;
+	}
+	return Scene;
+}
+
+bool FFICSceneFile::ReadSceneName(const FString& Path, FString& OutSceneName) {
+	TUniquePtr<FArchive> File(IFileManager::Get().CreateFileReader(*Path));
+	FString Error;
+	return File && ReadHeader(*File, OutSceneName, Error);
+}
@@ -55,7 +55,21 @@ UObject* UFICCamera::CreateNewObject(UObject* InOuter, AFICScene* InScene) {
 }
 
 TSharedRef<SWidget> UFICCamera::CreateDetailsWidget(UFICEditorContext* InContext) {
-	return InContext->GetEditorAttributes()[this]->CreateDetailsWidget(InContext);
+	return SNew(SVerticalBox)
+	+SVerticalBox::Slot().AutoHeight()[
+		InContext->GetEditorAttributes()[this]->CreateDetailsWidget(InContext)
+	]
+	+SVerticalBox::Slot().AutoHeight()[
+		SNew(SCheckBox)
+		.Content()[SNew(STextBlock).Text(FText::FromString("Render Output"))]
+		.IsChecked_Lambda([this]() {
+			return bRenderOutput ? ECheckBoxState::Checked : ECheckBoxState::Unchecked;
+		})
+		.OnCheckStateChanged_Lambda([this](ECheckBoxState State) {
+			bRenderOutput = State == ECheckBoxState::Checked;
+		})
+		.ToolTipText(FText::FromString(TEXT("If enabled, this camera gets captured into its own image sequence when the scene gets rendered with multi camera render enabled.")))
+	];
 }
 
 void UFICCamera::InitEditor(UFICEditorContext* Context) {
@@ -114,10 +128,13 @@ void UFICCamera::SetSceneObjectTransform(FTransform InTransform) {
 	if (EditorCameraActor) {
 		EditorCameraActor->SetActorTransform(InTransform);
 		EditorContext->CommitAutoKeyframe(this);
-		FRotator LastRotation = FFICAttributeRotation::FromEditorAttribute(EditorContext->GetEditorAttributes()[this]->Get<FFICEditorAttributeGroup>("Rotation"));
-		FRotator NewRotation = UFICUtils::AdditiveRotation(LastRotation, InTransform.Rotator());
-		FFICAttributePosition::ToEditorAttribute(InTransform.GetLocation(), EditorContext->GetEditorAttributes()[this]->Get<FFICEditorAttributeGroup>("Position"));
-		FFICAttributeRotation::ToEditorAttribute(NewRotation, EditorContext->GetEditorAttributes()[this]->Get<FFICEditorAttributeGroup>("Rotation"));
+		{
+			FFICEditBatchScope EditBatch(EditorContext);
+			FRotator LastRotation = FFICAttributeRotation::FromEditorAttribute(EditorContext->GetEditorAttributes()[this]->Get<FFICEditorAttributeGroup>("Rotation"));
+			FRotator NewRotation = UFICUtils::AdditiveRotation(LastRotation, InTransform.Rotator());
+			FFICAttributePosition::ToEditorAttribute(InTransform.GetLocation(), EditorContext->GetEditorAttributes()[this]->Get<FFICEditorAttributeGroup>("Position"));
+			FFICAttributeRotation::ToEditorAttribute(NewRotation, EditorContext->GetEditorAttributes()[this]->Get<FFICEditorAttributeGroup>("Rotation"));
+		}
 		EditorContext->CommitAutoKeyframe(nullptr);
 	}
 }
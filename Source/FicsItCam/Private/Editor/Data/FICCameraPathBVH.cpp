@@ -0,0 +1,95 @@
+#include "Editor/Data/FICCameraPathBVH.h"
+
+void FFICCameraPathBVH::Build(const TArray<FVector>& Points) {
+	NumPoints = Points.Num();
+	Nodes.Empty(FMath::Max(2 * GetNumSegments() / MaxLeafSegments, 1));
+	if (NumPoints > 0) BuildNode(Points, 0, GetNumSegments());
+}
+
+void FFICCameraPathBVH::Refit(const TArray<FVector>& Points, int32 FirstPoint, int32 LastPoint) {
+	check(Points.Num() == NumPoints);
+	
+	// a point belongs to the segment before and after it
+	int32 FirstSegment = FirstPoint - 1;
+	int32 LastSegment = LastPoint;
+
+	// children follow their parents, so updating in reverse order refits children first
+	for (int32 i = Nodes.Num()-1; i >= 0; --i) {
+		FNode& Node = Nodes[i];
+		if (Node.SegmentEnd <= FirstSegment || Node.SegmentBegin > LastSegment) continue;
+		if (Node.SecondChild == INDEX_NONE) {
+			Node.Bounds = GetSegmentBounds(Points, Node.SegmentBegin, Node.SegmentEnd);
+		} else {
+			Node.Bounds = Nodes[i+1].Bounds + Nodes[Node.SecondChild].Bounds;
+		}
+	}
+}
+
+bool FFICCameraPathBVH::Raycast(const TArray<FVector>& Points, const FRay& Ray, float Radius, int32& OutSegment, float& OutAlpha, float& OutDistance) const {
+	if (Nodes.Num() < 1 || Points.Num() != NumPoints) return false;
+
+	const FVector RayEnd = Ray.Origin + Ray.Direction * HALF_WORLD_MAX;
+	const FVector RayDelta = RayEnd - Ray.Origin;
+	const FVector Expand(Radius);
+	
+	bool bHit = false;
+	OutDistance = TNumericLimits<float>::Max();
+	
+	TArray<int32, TInlineAllocator<64>> Stack;
+	Stack.Push(0);
+	while (Stack.Num() > 0) {
+		const FNode& Node = Nodes[Stack.Pop(false)];
+		if (!FMath::LineBoxIntersection(Node.Bounds.ExpandBy(Expand), Ray.Origin, RayEnd, RayDelta)) continue;
+		
+		if (Node.SecondChild != INDEX_NONE) {
+			Stack.Push(Node.SecondChild);
+			Stack.Push(&Node - Nodes.GetData() + 1);
+			continue;
+		}
+
+		for (int32 Segment = Node.SegmentBegin; Segment < Node.SegmentEnd; ++Segment) {
+			const FVector& Start = Points[Segment];
+			const FVector& End = Points[FMath::Min(Segment + 1, NumPoints - 1)];
+			FVector OnRay, OnSegment;
+			FMath::SegmentDistToSegmentSafe(Ray.Origin, RayEnd, Start, End, OnRay, OnSegment);
+			if (FVector::DistSquared(OnRay, OnSegment) > Radius * Radius) continue;
+			
+			float Distance = FVector::Distance(OnSegment, Ray.Origin);
+			if (Distance < OutDistance) {
+				float Length = FVector::Distance(Start, End);
+				OutDistance = Distance;
+				OutSegment = Segment;
+				OutAlpha = Length > SMALL_NUMBER ? FVector::Distance(Start, OnSegment) / Length : 0.0f;
+				bHit = true;
+			}
+		}
+	}
+	return bHit;
+}
+
+FBox FFICCameraPathBVH::GetSegmentBounds(const TArray<FVector>& Points, int32 SegmentBegin, int32 SegmentEnd) {
+	FBox Bounds(ForceInit);
+	for (int32 i = SegmentBegin; i <= FMath::Min(SegmentEnd, Points.Num() - 1); ++i) {
+		Bounds += Points[i];
+	}
+	return Bounds;
+}
+
+int32 FFICCameraPathBVH::BuildNode(const TArray<FVector>& Points, int32 SegmentBegin, int32 SegmentEnd) {
+	int32 Index = Nodes.Num();
+	FNode& Node = Nodes.AddDefaulted_GetRef();
+	Node.SegmentBegin = SegmentBegin;
+	Node.SegmentEnd = SegmentEnd;
+	if (SegmentEnd - SegmentBegin <= MaxLeafSegments) {
+		Node.Bounds = GetSegmentBounds(Points, SegmentBegin, SegmentEnd);
+		return Index;
+	}
+
+	int32 Middle = SegmentBegin + (SegmentEnd - SegmentBegin) / 2;
+	BuildNode(Points, SegmentBegin, Middle);
+	int32 SecondChild = BuildNode(Points, Middle, SegmentEnd);
+	// the node reference might be invalid due to reallocation
+	Nodes[Index].SecondChild = SecondChild;
+	Nodes[Index].Bounds = Nodes[Index+1].Bounds + Nodes[SecondChild].Bounds;
+	return Index;
+}
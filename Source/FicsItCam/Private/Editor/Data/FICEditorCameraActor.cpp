@@ -72,14 +72,29 @@ uint32 FFICEditorCameraPathSceneProxy::GetMemoryFootprint() const {
 }*/
 
 void UFICEditorCameraPathComponent::UpdateFramePoints() {
+	int32 OldNum = FramePoints.Num();
+	int32 FirstChanged = TNumericLimits<int32>::Max();
+	int32 LastChanged = INDEX_NONE;
 	FramePoints.SetNumUninitialized(EditorContext->GetScene()->AnimationRange.Length());
-	FramePoints.SetNumUninitialized(0, false);
 	KeyframePoints.Empty();
+	int32 Index = 0;
 	for (int64 Time : EditorContext->GetScene()->AnimationRange) {
+		if (Index >= FramePoints.Num()) break;
 		bool bIsKeyframe = EditorContext->GetEditorAttributes()[Camera]->Get<FFICEditorAttributeBase>("Position").GetKeyframe(Time).IsValid();
 		FVector Loc = FFICAttributePosition::FromEditorAttribute(EditorContext->GetEditorAttributes()[Camera]->Get<FFICEditorAttributeGroup>("Position"), Time);
-		if (bIsKeyframe) KeyframePoints.Add(FramePoints.Num());
-		FramePoints.Add(Loc);
+		if (bIsKeyframe) KeyframePoints.Add(Index);
+		if (Index >= OldNum || FramePoints[Index] != Loc) {
+			FirstChanged = FMath::Min(FirstChanged, Index);
+			LastChanged = Index;
+		}
+		FramePoints[Index++] = Loc;
+	}
+	FramePoints.SetNum(Index, false);
+
+	if (FramePoints.Num() != PathBVH.GetNumPoints()) {
+		PathBVH.Build(FramePoints);
+	} else if (LastChanged != INDEX_NONE) {
+		PathBVH.Refit(FramePoints, FirstChanged, LastChanged);
 	}
 }
 
@@ -159,7 +174,7 @@ UObject* AFICEditorCameraActor::Select() {
 
 void AFICEditorCameraActor::UpdateValues(TSharedRef<FFICEditorAttributeBase> Attribute) {
 	FVector Pos = FFICAttributePosition::FromEditorAttribute(Attribute->Get<FFICEditorAttributeGroup>("Position"));
-	FRotator Rot = FFICAttributeRotation::FromEditorAttribute(Attribute->Get<FFICEditorAttributeGroup>("Rotation"));
+	FRotator Rot = FFICAttributeRotation::FromEditorAttribute(Attribute->Get<FFICEditorAttributeGroup>("Rotation"), EditorContext->GetCurrentFrame());
 	SetActorLocation(Pos);
 	SetActorRotation(Rot);
 	CaptureComponent->FOVAngle = Attribute->Get("Lens Settings").Get<TFICEditorAttribute<FFICFloatAttribute>>("FOV").GetValue();
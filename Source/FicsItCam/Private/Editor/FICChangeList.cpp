@@ -1,8 +1,13 @@
 #include "Editor/FICChangeList.h"
 
+#include "FICStats.h"
 #include "FICSubsystem.h"
 #include "Editor/FICEditorContext.h"
 
+DECLARE_MEMORY_STAT(TEXT("Undo History"), STAT_FICUndoHistoryMemory, STATGROUP_FicsItCam);
+DECLARE_CYCLE_STAT(TEXT("Undo Snapshot Capture"), STAT_FICUndoSnapshotCapture, STATGROUP_FicsItCam);
+DECLARE_CYCLE_STAT(TEXT("Undo Push Change"), STAT_FICUndoPushChange, STATGROUP_FicsItCam);
+
 TArray<FChangeStackEntry> FFICChange::ChangeStack = TArray<FChangeStackEntry>();
 
 FFICChange_ActiveFrame::FFICChange_ActiveFrame(UFICEditorContext* InEditorContext, int64 InFromFrame, int64 InToFrame) : EditorContext(InEditorContext), FromFrame(InFromFrame), ToFrame(InToFrame) {
@@ -38,6 +43,131 @@ void FFICChange_ActiveFrame::UndoChange() {
 	EditorContext->SetCurrentFrame(FromFrame);
 }
 
+bool FFICChange_Attribute::IsStackable(TSharedRef<FFICChange> InChange) {
+	if (!ChangeSource.IsValid()) return false;
+	if (InChange->ChangeType() == ChangeType()) {
+		return ChangeSource == StaticCastSharedRef<FFICChange_Attribute>(InChange)->ChangeSource;
+	}
+	if (InChange->ChangeType() == TEXT("AttributeDelta")) {
+		TSharedRef<FFICChange_AttributeDelta> Delta = StaticCastSharedRef<FFICChange_AttributeDelta>(InChange);
+		return Delta->Attribute == Attribute && ChangeSource == Delta->ChangeSource;
+	}
+	return false;
+}
+
+void FFICChange_Attribute::Stack(TSharedRef<FFICChange> InChange) {
+	if (InChange->ChangeType() == ChangeType()) {
+		ToAttribute = StaticCastSharedRef<FFICChange_Attribute>(InChange)->ToAttribute;
+		bCaptureToOnUndo = false;
+	} else {
+		bCaptureToOnUndo = true;
+	}
+}
+
+FFICKeyframeState FFICKeyframeState::Capture(FFICAttribute* Attribute, FICFrame Frame) {
+	FFICKeyframeState State;
+	TSharedRef<FFICKeyframe>* Keyframe = Attribute->GetKeyframes().Find(Frame);
+	if (Keyframe) {
+		State.bExists = true;
+		State.Value = (*Keyframe)->GetValue();
+		State.InControl = (*Keyframe)->GetInControl();
+		State.OutControl = (*Keyframe)->GetOutControl();
+		State.Type = (*Keyframe)->GetType();
+	}
+	return State;
+}
+
+void FFICKeyframeState::Restore(FFICAttribute* Attribute, FICFrame Frame) const {
+	if (!bExists) {
+		Attribute->RemoveKeyframe(Frame);
+		return;
+	}
+	TSharedRef<FFICKeyframe> Keyframe = Attribute->AddKeyframe(Frame);
+	Keyframe->SetValue(Value);
+	Keyframe->SetInControl(InControl);
+	Keyframe->SetOutControl(OutControl);
+	Keyframe->SetType(Type);
+}
+
+FFICChange_AttributeDelta::FFICChange_AttributeDelta(FFICAttribute* InAttribute, const TArray<FICFrame>& InFrames, FFICChangeSource InChangeSource) : Attribute(InAttribute), ChangeSource(InChangeSource) {
+	SCOPE_CYCLE_COUNTER(STAT_FICUndoSnapshotCapture);
+	
+	TFunction<void(FFICAttribute*)> CaptureBefore;
+	CaptureBefore = [this, &InFrames, &CaptureBefore](FFICAttribute* InAttrib) {
+		TMap<FString, FFICAttribute*> Children = InAttrib->GetChildAttributes();
+		if (Children.Num() > 0) {
+			for (const TPair<FString, FFICAttribute*>& Child : Children) CaptureBefore(Child.Value);
+			return;
+		}
+		TMap<FICFrame, FFICKeyframeState>& States = FromKeyframes.Add(InAttrib);
+		for (FICFrame Frame : InFrames) {
+			States.Add(Frame, FFICKeyframeState::Capture(InAttrib, Frame));
+			FICFrame Neighbour;
+			if (InAttrib->GetPrevKeyframe(Frame, Neighbour)) States.Add(Neighbour, FFICKeyframeState::Capture(InAttrib, Neighbour));
+			if (InAttrib->GetNextKeyframe(Frame, Neighbour)) States.Add(Neighbour, FFICKeyframeState::Capture(InAttrib, Neighbour));
+		}
+	};
+	CaptureBefore(Attribute);
+}
+
+void FFICChange_AttributeDelta::CaptureAfter() {
+	SCOPE_CYCLE_COUNTER(STAT_FICUndoSnapshotCapture);
+	
+	for (const TPair<FFICAttribute*, TMap<FICFrame, FFICKeyframeState>>& Leaf : FromKeyframes) {
+		TMap<FICFrame, FFICKeyframeState>& States = ToKeyframes.FindOrAdd(Leaf.Key);
+		for (const TPair<FICFrame, FFICKeyframeState>& State : Leaf.Value) {
+			States.Add(State.Key, FFICKeyframeState::Capture(Leaf.Key, State.Key));
+		}
+	}
+}
+
+void FFICChange_AttributeDelta::RedoChange() {
+	ApplyKeyframes(ToKeyframes);
+}
+
+void FFICChange_AttributeDelta::UndoChange() {
+	ApplyKeyframes(FromKeyframes);
+}
+
+bool FFICChange_AttributeDelta::IsStackable(TSharedRef<FFICChange> InChange) {
+	if (InChange->ChangeType() == ChangeType() && ChangeSource.IsValid()) {
+		TSharedRef<FFICChange_AttributeDelta> Delta = StaticCastSharedRef<FFICChange_AttributeDelta>(InChange);
+		return Delta->Attribute == Attribute && ChangeSource == Delta->ChangeSource;
+	}
+	return false;
+}
+
+void FFICChange_AttributeDelta::Stack(TSharedRef<FFICChange> InChange) {
+	TSharedRef<FFICChange_AttributeDelta> Delta = StaticCastSharedRef<FFICChange_AttributeDelta>(InChange);
+	// keep the oldest known state of every keyframe and the newest state after the change
+	for (const TPair<FFICAttribute*, TMap<FICFrame, FFICKeyframeState>>& Leaf : Delta->FromKeyframes) {
+		TMap<FICFrame, FFICKeyframeState>& States = FromKeyframes.FindOrAdd(Leaf.Key);
+		for (const TPair<FICFrame, FFICKeyframeState>& State : Leaf.Value) {
+			if (!States.Contains(State.Key)) States.Add(State.Key, State.Value);
+		}
+	}
+	for (const TPair<FFICAttribute*, TMap<FICFrame, FFICKeyframeState>>& Leaf : Delta->ToKeyframes) {
+		ToKeyframes.FindOrAdd(Leaf.Key).Append(Leaf.Value);
+	}
+}
+
+SIZE_T FFICChange_AttributeDelta::GetAllocatedSize() const {
+	SIZE_T Size = sizeof(FFICChange_AttributeDelta) + FromKeyframes.GetAllocatedSize() + ToKeyframes.GetAllocatedSize();
+	for (const TPair<FFICAttribute*, TMap<FICFrame, FFICKeyframeState>>& Leaf : FromKeyframes) Size += Leaf.Value.GetAllocatedSize();
+	for (const TPair<FFICAttribute*, TMap<FICFrame, FFICKeyframeState>>& Leaf : ToKeyframes) Size += Leaf.Value.GetAllocatedSize();
+	return Size;
+}
+
+void FFICChange_AttributeDelta::ApplyKeyframes(const TMap<FFICAttribute*, TMap<FICFrame, FFICKeyframeState>>& InKeyframes) {
+	for (const TPair<FFICAttribute*, TMap<FICFrame, FFICKeyframeState>>& Leaf : InKeyframes) {
+		Leaf.Key->LockUpdateEvent();
+		for (const TPair<FICFrame, FFICKeyframeState>& State : Leaf.Value) {
+			State.Value.Restore(Leaf.Key, State.Key);
+		}
+		Leaf.Key->UnlockUpdateEvent();
+	}
+}
+
 void FFICChange_AddSceneObject::RedoChange() {
 	UObject* SceneObject = Context->FindSceneObject(SceneObjectName);
 	if (SceneObject) return;
@@ -83,20 +213,34 @@ void FFICChange_RemoveSceneObject::UndoChange() {
 	Context->SetSelectedSceneObject(SceneObject);
 }
 
+FFICChangeList::~FFICChangeList() {
+	DEC_MEMORY_STAT_BY(STAT_FICUndoHistoryMemory, MemoryUsage);
+}
+
 void FFICChangeList::PushChange(TSharedRef<FFICChange> InChange) {
-	if (Changes.Num() > 0) {
+	SCOPE_CYCLE_COUNTER(STAT_FICUndoPushChange);
+	
+	if (Changes.Num() > 0 && ChangeIndex == Changes.Num()-1) {
 		TSharedRef<FFICChange> Change = Changes[Changes.Num()-1];
 		if (Change->IsStackable(InChange)) {
 			Change->Stack(InChange);
+			UpdateChangeSize(Changes.Num()-1);
+			EnforceMemoryBudget();
 			return;
 		}
 	}
-	if (Changes.Num() > ChangeIndex+1) Changes.RemoveAt(ChangeIndex+1, Changes.Num() - ChangeIndex - 1);
+	while (Changes.Num() > ChangeIndex+1) {
+		MemoryUsage -= ChangeSizes.Last();
+		DEC_MEMORY_STAT_BY(STAT_FICUndoHistoryMemory, ChangeSizes.Last());
+		Changes.Pop(false);
+		ChangeSizes.Pop(false);
+	}
 	Changes.Push(InChange);
+	ChangeSizes.Push(InChange->GetAllocatedSize());
+	MemoryUsage += ChangeSizes.Last();
+	INC_MEMORY_STAT_BY(STAT_FICUndoHistoryMemory, ChangeSizes.Last());
 
-	if (Changes.Num() > MaxChanges) {
-		Changes.RemoveAt(0, Changes.Num() - MaxChanges);
-	}
+	EnforceMemoryBudget();
 	
 	ChangeIndex = Changes.Num() - 1;
 }
@@ -108,10 +252,42 @@ TSharedPtr<FFICChange> FFICChangeList::PushChange() {
 
 TSharedPtr<FFICChange> FFICChangeList::PopChange() {
 	if (ChangeIndex < 0) return nullptr;
-	return Changes[ChangeIndex--];
+	TSharedRef<FFICChange> Change = Changes[ChangeIndex];
+	// stacked changes capture their resulting state only now, which can grow them considerably
+	Change->PrepareUndo();
+	UpdateChangeSize(ChangeIndex--);
+	EnforceMemoryBudget();
+	return Change;
 }
 
 TSharedPtr<FFICChange> FFICChangeList::PeakChange() {
 	if (ChangeIndex < 0) return nullptr;
 	return Changes[ChangeIndex];
 }
+
+void FFICChangeList::SetMemoryBudget(SIZE_T InMemoryBudget) {
+	MemoryBudget = InMemoryBudget;
+	EnforceMemoryBudget();
+}
+
+void FFICChangeList::UpdateChangeSize(int32 Index) {
+	SIZE_T& ChangeSize = ChangeSizes[Index];
+	DEC_MEMORY_STAT_BY(STAT_FICUndoHistoryMemory, ChangeSize);
+	MemoryUsage -= ChangeSize;
+	ChangeSize = Changes[Index]->GetAllocatedSize();
+	MemoryUsage += ChangeSize;
+	INC_MEMORY_STAT_BY(STAT_FICUndoHistoryMemory, ChangeSize);
+}
+
+void FFICChangeList::EnforceMemoryBudget() {
+	int32 Evict = 0;
+	while (Evict < Changes.Num()-1 && MemoryUsage > MemoryBudget) {
+		MemoryUsage -= ChangeSizes[Evict];
+		DEC_MEMORY_STAT_BY(STAT_FICUndoHistoryMemory, ChangeSizes[Evict]);
+		++Evict;
+	}
+	if (Evict < 1) return;
+	Changes.RemoveAt(0, Evict);
+	ChangeSizes.RemoveAt(0, Evict);
+	ChangeIndex = FMath::Max(ChangeIndex - Evict, -1);
+}
@@ -93,20 +93,31 @@ void AFICEditorCameraCharacter::Tick(float DeltaSeconds) {
 					UpdateValues();
 				}
 
-				FRotator RotOld = FFICAttributeRotation::FromEditorAttribute(EditorContext->GetCameraEditor()->Get<FFICEditorAttributeGroup>("Rotation"));
+				FFICEditorAttributeGroup& RotationAttribute = EditorContext->GetCameraEditor()->Get<FFICEditorAttributeGroup>("Rotation");
+				FRotator RotOld = FFICAttributeRotation::FromEditorAttribute(RotationAttribute);
+				FRotator RotPreview = FFICAttributeRotation::FromEditorAttribute(RotationAttribute, EditorContext->GetCurrentFrame());
 				FVector PosOld = FFICAttributePosition::FromEditorAttribute(EditorContext->GetCameraEditor()->Get<FFICEditorAttributeGroup>("Position"));
 				FVector PosNew = GetActorLocation();
 				FRotator RotNew = GetController()->GetControlRotation();
+				RotNew.Roll = RollRotationFixValue;
 
 				// Patch Rotation
-				RotNew = UFICUtils::AdditiveRotation(RotOld, RotNew);
-				RotNew.Roll = RollRotationFixValue;
+				if (RotNew.Quaternion().AngularDistance(RotPreview.Quaternion()) < KINDA_SMALL_NUMBER) {
+					// the view still shows the previewed (f.e. quaternion interpolated) rotation, keep the values as they are
+					RotNew = RotOld;
+				} else {
+					RotNew = UFICUtils::AdditiveRotation(RotOld, RotNew);
+					RotNew.Roll = RollRotationFixValue;
+				}
 
 				if (bWasChangedDirectly) EditorContext->bInAutoKeyframeSet = true;
 				EditorContext->CommitAutoKeyframe(this);
 				bChangedByMovement = true;
-				FFICAttributePosition::ToEditorAttribute(PosNew, EditorContext->GetCameraEditor()->Get<FFICEditorAttributeGroup>("Position"));
-				FFICAttributeRotation::ToEditorAttribute(RotNew, EditorContext->GetCameraEditor()->Get<FFICEditorAttributeGroup>("Rotation"));
+				{
+					FFICEditBatchScope EditBatch(EditorContext);
+					FFICAttributePosition::ToEditorAttribute(PosNew, EditorContext->GetCameraEditor()->Get<FFICEditorAttributeGroup>("Position"));
+					FFICAttributeRotation::ToEditorAttribute(RotNew, RotationAttribute);
+				}
 				bChangedByMovement = false;
 				EditorContext->CommitAutoKeyframe(nullptr);
 				if (bWasChangedDirectly) EditorContext->bInAutoKeyframeSet = false;
@@ -301,7 +312,7 @@ void AFICEditorCameraCharacter::SetEditorContext(UFICEditorContext* InEditorCont
 void AFICEditorCameraCharacter::UpdateValues() {
 	if (EditorContext && EditorContext->GetCamera() && !bChangedByMovement) {
 		FVector Pos = FFICAttributePosition::FromEditorAttribute(EditorContext->GetCameraEditor()->Get<FFICEditorAttributeGroup>("Position"));
-		FRotator Rot = FFICAttributeRotation::FromEditorAttribute(EditorContext->GetCameraEditor()->Get<FFICEditorAttributeGroup>("Rotation"));
+		FRotator Rot = FFICAttributeRotation::FromEditorAttribute(EditorContext->GetCameraEditor()->Get<FFICEditorAttributeGroup>("Rotation"), EditorContext->GetCurrentFrame());
 		if (EditorContext->GetLockCameraToView()) {
 			SetActorLocation(Pos);
 			SetActorRotation(Rot);
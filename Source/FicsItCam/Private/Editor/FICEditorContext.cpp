@@ -4,6 +4,7 @@
 #include "Blueprint/WidgetBlueprintLibrary.h"
 #include "Data/Objects/FICCamera.h"
 #include "Data/Objects/FICSceneObject.h"
+#include "Data/Objects/FICSceneObject3D.h"
 #include "Editor/Data/FICEditorAttributeBool.h"
 
 void UFICEditorContext::SetAnimPlayer(EFICAnimPlayerState InAnimPlayerState, float InAnimPlayerFactor) {
@@ -34,10 +35,7 @@ void UFICEditorContext::Load(AFICEditorCameraCharacter* InEditorPlayerCharacter,
 
 	ActiveSceneObjectManager.Initialize(InScene);
 	ActiveSceneObjectManager.IsSceneObjectActive.BindLambda([this](UObject* SceneObject, FICFrameFloat Frame) {
-		IFICSceneObjectActive* Active = Cast<IFICSceneObjectActive>(SceneObject);
-		TSharedRef<FFICEditorAttributeBase>* Attrib = EditorAttributeMap.Find(&Active->GetActiveAttribute());
-		if (!Attrib) return false;
-		return StaticCastSharedRef<FFICEditorAttributeBool>(*Attrib)->GetActiveValue();
+		return IsSceneObjectActive(SceneObject);
 	});
 
 	if (Scene->bViewportEverSaved) {
@@ -75,6 +73,17 @@ void UFICEditorContext::Tick(float DeltaTime) {
 		default: ;
 		}
 
+		FlushAttributeUpdates();
+
+		if (StaleSceneObjects.Num() > 0) {
+			TArray<UObject*> SceneObjects;
+			for (TSet<UObject*>::TIterator It = StaleSceneObjects.CreateIterator(); It && SceneObjects.Num() < StaleSceneObjectRefreshesPerTick; ++It) {
+				SceneObjects.Add(*It);
+				It.RemoveCurrent();
+			}
+			RefreshSceneObjects(SceneObjects);
+		}
+
 		for (UObject* SceneObject : GetScene()->GetSceneObjects()) {
 			IFICSceneObject* ActiveSceneObject = Cast<IFICSceneObject>(SceneObject);
 			if (ActiveSceneObject) {
@@ -94,41 +103,162 @@ void UFICEditorContext::LoadSceneObject(UObject* SceneObject) {
 	AllAttributes->AddAttribute(FString::FromInt(SceneObject->GetUniqueID()), Attribute);
 	EditorAttributes.Add(SceneObject, Attribute);
 	TFunction<void(TSharedRef<FFICEditorAttributeBase>)> AddEditAttrib;
-	AddEditAttrib = [this, &AddEditAttrib](TSharedRef<FFICEditorAttributeBase> Attrib) {
-		EditorAttributeMap.Add(&Attrib->GetAttribute(), Attrib);
-		for (const TPair<FString, TSharedRef<FFICEditorAttributeBase>>& Child : Attrib->GetChildAttributes()) {
+	TArray<TPair<FFICAttribute*, FDelegateHandle>>& UpdateHandles = DataAttributeOnUpdateDelegateHandles.Add(SceneObject);
+	AddEditAttrib = [this, &AddEditAttrib, &UpdateHandles](TSharedRef<FFICEditorAttributeBase> Attrib) {
+		FFICAttribute* DataAttribute = &Attrib->GetAttribute();
+		EditorAttributeMap.Add(DataAttribute, Attrib);
+		TMap<FString, TSharedRef<FFICEditorAttributeBase>> Children = Attrib->GetChildAttributes();
+		for (const TPair<FString, TSharedRef<FFICEditorAttributeBase>>& Child : Children) {
+			AttributeParents.Add(&Child.Value->GetAttribute(), DataAttribute);
 			AddEditAttrib(Child.Value);
 		}
+		if (Children.Num() > 0) return;
+		// groups forward every update of their children, so listening to the keyframe holding attributes is enough
+		UpdateHandles.Add(TPair<FFICAttribute*, FDelegateHandle>(DataAttribute, DataAttribute->OnUpdate.AddLambda([this, DataAttribute]() {
+			PendingUpdatedAttributes.Add(DataAttribute);
+			if (!bBlockValueUpdate) PendingValueUpdates.Add(DataAttribute);
+		})));
 	};
+	AttributeParents.Add(&Attribute->GetAttribute(), &AllAttributes->GetAttribute());
 	AddEditAttrib(Attribute);
-	Attribute->OnValueChanged.AddLambda([this, Attribute, SceneObject]() {
-		Cast<IFICSceneObject>(SceneObject)->EditorUpdate(this, Attribute);
-		if (bAutoKeyframe && !bInAutoKeyframeSet && AutoKeyframeChangeRef) {
-			bInAutoKeyframeSet = true;
-			bBlockValueUpdate = true;
+	Attribute->OnValueChanged.AddLambda([this, SceneObject]() {
+		if (EditBatchDepth > 0) {
+			PendingEditBatchObjects.AddUnique(SceneObject);
+			return;
+		}
+		OnSceneObjectValueChanged(SceneObject);
+	});
+
+	Cast<IFICSceneObject>(SceneObject)->InitEditor(this);
+
+	ActiveSceneObjectManager.Invalidate();
+	ActiveSceneObjectManager.UpdateActiveObjects(GetCurrentFrame());
+}
+
+void UFICEditorContext::OnSceneObjectValueChanged(UObject* SceneObject) {
+	TSharedRef<FFICEditorAttributeBase> Attribute = EditorAttributes[SceneObject];
+	Cast<IFICSceneObject>(SceneObject)->EditorUpdate(this, Attribute);
+	if (bAutoKeyframe && !bInAutoKeyframeSet && AutoKeyframeChangeRef) {
+		bInAutoKeyframeSet = true;
+		bBlockValueUpdate = true;
+		FFICChangeSource ChangeSource(AutoKeyframeChangeRef, FString::FromInt(GetCurrentFrame()));
+		// deltas continuing the last change get stacked, only new changes may become a full checkpoint
+		bool bCheckpoint = !(ChangeSource == LastAutoKeyframeSource) && ++AutoKeyframeDeltas >= AutoKeyframeCheckpointInterval;
+		LastAutoKeyframeSource = ChangeSource;
+		if (bCheckpoint) {
+			AutoKeyframeDeltas = 0;
 			FFICChange::ChangeStack.Push(FChangeStackEntry(&Attribute->GetAttribute(), Attribute->GetAttribute().Get()));
 
+			Attribute->GetAttribute().LockUpdateEvent();
 			Attribute->SetKeyframe(GetCurrentFrame());
+			Attribute->GetAttribute().UnlockUpdateEvent();
 
 			FChangeStackEntry StackEntry = FFICChange::ChangeStack.Pop();
-			ChangeList.PushChange(MakeShared<FFICChange_Attribute>(StackEntry.Key, StackEntry.Value, FFICChangeSource(AutoKeyframeChangeRef, FString::FromInt(GetCurrentFrame()))));
-			bBlockValueUpdate = false;
-			bInAutoKeyframeSet = false;
+			ChangeList.PushChange(MakeShared<FFICChange_Attribute>(StackEntry.Key, StackEntry.Value, ChangeSource));
+		} else {
+			TSharedRef<FFICChange_AttributeDelta> Change = MakeShared<FFICChange_AttributeDelta>(&Attribute->GetAttribute(), TArray<FICFrame>{GetCurrentFrame()}, ChangeSource);
+			
+			Attribute->GetAttribute().LockUpdateEvent();
+			Attribute->SetKeyframe(GetCurrentFrame());
+			Attribute->GetAttribute().UnlockUpdateEvent();
+
+			Change->CaptureAfter();
+			ChangeList.PushChange(Change);
 		}
-		
-		if (!bInAutoKeyframeSet) {
-			IFICSceneObjectActive* SceneObjectActive = Cast<IFICSceneObjectActive>(SceneObject);
-			if (SceneObjectActive) ActiveSceneObjectManager.UpdateActiveObjects(GetCurrentFrame());
+		bBlockValueUpdate = false;
+		bInAutoKeyframeSet = false;
+	}
+	
+	if (!bInAutoKeyframeSet) {
+		IFICSceneObjectActive* SceneObjectActive = Cast<IFICSceneObjectActive>(SceneObject);
+		if (SceneObjectActive) ActiveSceneObjectManager.UpdateActiveObjects(GetCurrentFrame());
+	}
+}
+
+void UFICEditorContext::BeginEditBatch() {
+	++EditBatchDepth;
+}
+
+void UFICEditorContext::EndEditBatch() {
+	if (--EditBatchDepth > 0) return;
+	EditBatchDepth = 0;
+	TArray<UObject*> SceneObjects = MoveTemp(PendingEditBatchObjects);
+	for (UObject* SceneObject : SceneObjects) {
+		if (EditorAttributes.Contains(SceneObject)) OnSceneObjectValueChanged(SceneObject);
+	}
+}
+
+void UFICEditorContext::FlushAttributeUpdates() {
+	if (PendingUpdatedAttributes.Num() < 1) return;
+	TSet<FFICAttribute*> UpdatedAttributes = MoveTemp(PendingUpdatedAttributes);
+	TSet<FFICAttribute*> ValueUpdates = MoveTemp(PendingValueUpdates);
+
+	if (ValueUpdates.Num() > 0) {
+		bInAutoKeyframeSet = true;
+		{
+			FFICEditBatchScope EditBatch(this);
+			for (FFICAttribute* Attribute : ValueUpdates) {
+				TSharedRef<FFICEditorAttributeBase>* EditorAttribute = EditorAttributeMap.Find(Attribute);
+				if (EditorAttribute) (*EditorAttribute)->UpdateValue(GetCurrentFrame());
+			}
 		}
-	});
-	DataAttributeOnUpdateDelegateHandles.Add(SceneObject, Attribute->GetAttribute().OnUpdate.AddLambda([this, Attribute]() {
-		if (bBlockValueUpdate) return;
-		Attribute->UpdateValue(GetCurrentFrame());
-	}));
+		bInAutoKeyframeSet = false;
+		ActiveSceneObjectManager.UpdateActiveObjects(GetCurrentFrame());
+	}
 
-	Cast<IFICSceneObject>(SceneObject)->InitEditor(this);
+	TArray<FFICAttribute*> Leaves = UpdatedAttributes.Array();
+	for (FFICAttribute* Attribute : Leaves) {
+		FFICAttribute** Parent = AttributeParents.Find(Attribute);
+		while (Parent) {
+			bool bAlreadyAdded;
+			UpdatedAttributes.Add(*Parent, &bAlreadyAdded);
+			if (bAlreadyAdded) break;
+			Parent = AttributeParents.Find(*Parent);
+		}
+	}
+	OnAttributesUpdated.Broadcast(UpdatedAttributes);
+}
 
-	ActiveSceneObjectManager.UpdateActiveObjects(GetCurrentFrame());
+bool UFICEditorContext::IsSceneObjectRelevant(UObject* SceneObject) {
+	if (SceneObject == SelectedSceneObject) return true;
+	IFICSceneObjectActive* Active = Cast<IFICSceneObjectActive>(SceneObject);
+	if (Active && (IsSceneObjectActive(SceneObject) || Active->GetActiveAttribute().GetValue(GetCurrentFrame()))) return true;
+	IFICSceneObject3D* Object3D = Cast<IFICSceneObject3D>(SceneObject);
+	if (Object3D) {
+		AActor* Actor = Object3D->GetActor();
+		if (Actor && Actor->WasRecentlyRendered(0.25f)) return true;
+	}
+	return false;
+}
+
+void UFICEditorContext::RefreshSceneObjects(const TArray<UObject*>& SceneObjects) {
+	bool bAnyActive = false;
+	bInAutoKeyframeSet = true;
+	{
+		FFICEditBatchScope EditBatch(this);
+		for (UObject* SceneObject : SceneObjects) {
+			TSharedRef<FFICEditorAttributeBase>* Attribute = EditorAttributes.Find(SceneObject);
+			if (!Attribute) continue;
+			(*Attribute)->UpdateValue(GetCurrentFrame());
+			bAnyActive |= !!Cast<IFICSceneObjectActive>(SceneObject);
+		}
+	}
+	bInAutoKeyframeSet = false;
+	if (bAnyActive) ActiveSceneObjectManager.UpdateActiveObjects(GetCurrentFrame());
+}
+
+void UFICEditorContext::EnsureSceneObjectUpToDate(UObject* SceneObject) {
+	if (StaleSceneObjects.Remove(SceneObject) > 0) RefreshSceneObjects({SceneObject});
+}
+
+bool UFICEditorContext::IsSceneObjectActive(UObject* SceneObject) {
+	IFICSceneObjectActive* Active = Cast<IFICSceneObjectActive>(SceneObject);
+	if (!Active) return false;
+	// the editor attributes of stale scene objects still contain the value of a previous frame
+	if (StaleSceneObjects.Contains(SceneObject)) return Active->GetActiveAttribute().GetValue(GetCurrentFrame());
+	TSharedRef<FFICEditorAttributeBase>* Attrib = EditorAttributeMap.Find(&Active->GetActiveAttribute());
+	if (!Attrib) return false;
+	return StaticCastSharedRef<FFICEditorAttributeBool>(*Attrib)->GetActiveValue();
 }
 
 void UFICEditorContext::UnloadSceneObject(UObject* SceneObject) {
@@ -137,10 +267,15 @@ void UFICEditorContext::UnloadSceneObject(UObject* SceneObject) {
 	if (GetSelectedSceneObject() == SceneObject) SetSelectedSceneObject(nullptr);
 	
 	AllAttributes->RemoveAttribute(FString::FromInt(SceneObject->GetUniqueID()));
-	EditorAttributes[SceneObject]->GetAttribute().OnUpdate.Remove(DataAttributeOnUpdateDelegateHandles[SceneObject]);
+	for (const TPair<FFICAttribute*, FDelegateHandle>& Handle : DataAttributeOnUpdateDelegateHandles[SceneObject]) {
+		Handle.Key->OnUpdate.Remove(Handle.Value);
+	}
 	TFunction<void(TSharedRef<FFICEditorAttributeBase>)> RemoveEditAttrib;
 	RemoveEditAttrib = [this, &RemoveEditAttrib](TSharedRef<FFICEditorAttributeBase> Attrib) {
 		EditorAttributeMap.Remove(&Attrib->GetAttribute());
+		AttributeParents.Remove(&Attrib->GetAttribute());
+		PendingUpdatedAttributes.Remove(&Attrib->GetAttribute());
+		PendingValueUpdates.Remove(&Attrib->GetAttribute());
 		for (const TPair<FString, TSharedRef<FFICEditorAttributeBase>>& Child : Attrib->GetChildAttributes()) {
 			RemoveEditAttrib(Child.Value);
 		}
@@ -148,6 +283,8 @@ void UFICEditorContext::UnloadSceneObject(UObject* SceneObject) {
 	RemoveEditAttrib(EditorAttributes[SceneObject]);
 	EditorAttributes.Remove(SceneObject);
 	DataAttributeOnUpdateDelegateHandles.Remove(SceneObject);
+	PendingEditBatchObjects.Remove(SceneObject);
+	StaleSceneObjects.Remove(SceneObject);
 
 	ActiveSceneObjectManager.UpdateActiveObjects(GetCurrentFrame());
 }
@@ -163,23 +300,22 @@ void UFICEditorContext::RemoveSceneObject(UObject* SceneObject) {
 	if (!SceneObject) return;
 	UnloadSceneObject(SceneObject);
 	Scene->RemoveSceneObject(SceneObject);
+	ActiveSceneObjectManager.Invalidate();
+	ActiveSceneObjectManager.UpdateActiveObjects(GetCurrentFrame());
 	OnSceneObjectsChanged.Broadcast();
 }
 
 void UFICEditorContext::MoveSceneObject(UObject* SceneObject, int Delta) {
 	if (!SceneObject) return;
 	Scene->MoveSceneObject(SceneObject, Delta);
+	ActiveSceneObjectManager.Invalidate();
+	ActiveSceneObjectManager.UpdateActiveObjects(GetCurrentFrame());
 	OnSceneObjectsChanged.Broadcast();
 	SetSelectedSceneObject(SceneObject);
 }
 
 UObject* UFICEditorContext::FindSceneObject(FString SceneObjectName) const {
-	for (UObject* Object : Scene->GetSceneObjects()) {
-		if (Cast<IFICSceneObject>(Object)->GetSceneObjectName() == SceneObjectName) {
-			return Object;
-		}
-	}
-	return nullptr;
+	return Scene->FindSceneObject(SceneObjectName);
 }
 
 AFICScene* UFICEditorContext::GetScene() const {
@@ -189,8 +325,8 @@ AFICScene* UFICEditorContext::GetScene() const {
 UFICCamera* UFICEditorContext::GetCamera() {
 	for (UObject* Object : Scene->GetSceneObjects()) {
 		UFICCamera* CameraObject = Cast<UFICCamera>(Object);
-		if (CameraObject) {
-			if (GetEditorAttributes()[CameraObject]->Get<FFICEditorAttributeBool>("Active").GetActiveValue()) return Cast<UFICCamera>(Object);
+		if (CameraObject && IsSceneObjectActive(CameraObject)) {
+			return CameraObject;
 		}
 	}
 	return nullptr;
@@ -199,14 +335,28 @@ UFICCamera* UFICEditorContext::GetCamera() {
 TSharedPtr<FFICEditorAttributeBase> UFICEditorContext::GetCameraEditor() {
 	UFICCamera* Camera = GetCamera();
 	if (!Camera) return nullptr;
-	return GetEditorAttributes()[GetCamera()];
+	EnsureSceneObjectUpToDate(Camera);
+	return GetEditorAttributes()[Camera];
 }
 
 void UFICEditorContext::SetCurrentFrame(FICFrame inFrame) {
 	CurrentFrame = inFrame;
 
+	// relevant scene objects get updated completely and all others are stale anyway
+	PendingValueUpdates.Empty();
+
 	bInAutoKeyframeSet = true;
-	AllAttributes->UpdateValue(inFrame);
+	{
+		FFICEditBatchScope EditBatch(this);
+		for (const TPair<UObject*, TSharedRef<FFICEditorAttributeBase>>& Attribute : EditorAttributes) {
+			if (IsSceneObjectRelevant(Attribute.Key)) {
+				StaleSceneObjects.Remove(Attribute.Key);
+				Attribute.Value->UpdateValue(inFrame);
+			} else {
+				StaleSceneObjects.Add(Attribute.Key);
+			}
+		}
+	}
 	UpdateCharacterValues();
 	OnCurrentFrameChanged.Broadcast();
 	bInAutoKeyframeSet = false;
@@ -229,7 +379,10 @@ FFICFrameRange UFICEditorContext::GetActiveRange() {
 void UFICEditorContext::SetSelectedSceneObject(UObject* SceneObject) {
 	if (SelectedSceneObject) Cast<IFICSceneObject>(SelectedSceneObject)->Unselect(this);
 	SelectedSceneObject = SceneObject;
-	if (SelectedSceneObject) Cast<IFICSceneObject>(SelectedSceneObject)->Select(this);
+	if (SelectedSceneObject) {
+		EnsureSceneObjectUpToDate(SelectedSceneObject);
+		Cast<IFICSceneObject>(SelectedSceneObject)->Select(this);
+	}
 	OnSceneObjectSelectionChanged.Broadcast();
 }
 
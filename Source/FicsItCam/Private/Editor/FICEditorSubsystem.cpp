@@ -23,8 +23,6 @@ void AFICEditorSubsystem::InitInteractiveTools() {
 	PDIRenderComponent = NewObject<UFICToolsContextRenderComponent>(PDIRenderActor);
 	PDIRenderActor->SetRootComponent(PDIRenderComponent);
 	PDIRenderComponent->RegisterComponent();
-	LineBatchComponent = NewObject<ULineBatchComponent>(PDIRenderActor);
-	LineBatchComponent->AttachToComponent(PDIRenderActor->GetRootComponent(), FAttachmentTransformRules::KeepRelativeTransform);
 
 	ToolsQueries = MakeShared<FFICToolsContextQueries>(ToolsContext, GetWorld());
 	ToolsTransactions = MakeShared<FFICToolsContextTransactions>();
@@ -207,12 +205,12 @@ void AFICEditorSubsystem::Tick(float DeltaTime) {
 			ToolsContext->GizmoManager->Tick(DeltaTime);
 
 			// render things
-			FRuntimeToolsFrameworkRenderImpl RenderAPI(LineBatchComponent, SceneView, CurrentViewCameraState);
+			FRuntimeToolsFrameworkRenderImpl RenderAPI(PDIRenderComponent, SceneView, CurrentViewCameraState);
 			ToolsContext->ToolManager->Render(&RenderAPI);
 			ToolsContext->GizmoManager->Render(&RenderAPI);
 
-			// force rendering flush so that PDI lines get drawn
-			FlushRenderingCommands();
+			// hand the changed PDI geometry over to the render thread
+			PDIRenderComponent->SubmitGeometry();
 		}
 		//double end = FPlatformTime::Seconds();
 		//UE_LOG(LogTemp, Warning, TEXT("code executed in %f seconds."), end-start);
@@ -239,6 +237,7 @@ void AFICEditorSubsystem::OpenEditor(AFICScene* InScene) {
 	Context->SetCameraPreview(bCameraPreview);
 	Context->bShowPath = bShowCameraPath;
 	Context->bForceResolution = bForceResolution;
+	Context->ChangeList.SetMemoryBudget((SIZE_T)FMath::Max(1, UndoHistoryBudgetMB) * 1024 * 1024);
 	
 	// Initialize Editor Player Character
 	// TODO: Persist "Viewport Camera Transform" sepperately in persistent editor storage for given scene
@@ -290,6 +289,7 @@ void AFICEditorSubsystem::CloseEditor() {
 	bCameraPreview = Context->GetCameraPreview();
 	bShowCameraPath = Context->bShowPath;
 	bForceResolution = Context->bForceResolution;
+	UndoHistoryBudgetMB = Context->ChangeList.GetMemoryBudget() / (1024 * 1024);
 	
 	AFICScene* Scene = Context->GetScene();
 
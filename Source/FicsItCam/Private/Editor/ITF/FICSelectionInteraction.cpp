@@ -109,31 +109,27 @@ void UFICSelectionInteraction::OnEndHover() {
 	LastHovered = nullptr;
 }
 
-bool UFICSelectionInteraction::HitCameraPath(const FRay& InRay, UFICCamera*& OutCamera, int32& OutFrame, float& OutDistance) {
+bool UFICSelectionInteraction::HitCameraPath(const FRay& InRay, UFICCamera*& OutCamera, int32& OutFrame, float& OutDistance, FICFrameFloat* OptOutSubFrame) {
 	UFICCamera* BestCamera = nullptr;
+	FICFrameFloat BestFrame = 0;
 	OutDistance = TNumericLimits<int32>::Max();
 	for (UObject* SceneObject : Context->GetScene()->GetSceneObjects()) {
 		UFICCamera* Camera = Cast<UFICCamera>(SceneObject);
 		if (!Camera || !Camera->EditorCameraActor) continue;
-		const TArray<FVector>& FramePoints = Camera->EditorCameraActor->CameraPathComponent->FramePoints;
-		for (int PointIndex = 0; PointIndex < FramePoints.Num(); ++PointIndex) {
-			const FVector& Point = FramePoints[PointIndex];
-			FVector ClosesPoint;
-			float Gap = FMath::PointDistToLine(Point, InRay.Direction, InRay.Origin, ClosesPoint);
-			if (Gap < 20) {
-				float OriginDistance = FVector::Distance(Point, InRay.Origin);
-				if (OriginDistance < OutDistance) {
-					OutDistance = OriginDistance;
-					OutFrame = Context->GetScene()->AnimationRange.Begin + PointIndex;
-					BestCamera = Camera;
-				}
-			}
-		}
-		if (BestCamera) {
-			OutCamera = BestCamera;
-			return true;
+		UFICEditorCameraPathComponent* Path = Camera->EditorCameraActor->CameraPathComponent;
+		int32 Segment;
+		float Alpha;
+		float Distance;
+		if (Path->PathBVH.Raycast(Path->FramePoints, InRay, 20, Segment, Alpha, Distance) && Distance < OutDistance) {
+			OutDistance = Distance;
+			BestFrame = Context->GetScene()->AnimationRange.Begin + Segment + Alpha;
+			BestCamera = Camera;
 		}
 	}
+	if (!BestCamera) return false;
 	
-	return false;
+	OutCamera = BestCamera;
+	OutFrame = FMath::RoundToInt(BestFrame);
+	if (OptOutSubFrame) *OptOutSubFrame = BestFrame;
+	return true;
 }
@@ -3,10 +3,18 @@
 #include "Editor/ITF/FICToolsContextRenderComponent.h"
 #include "PrimitiveSceneProxy.h"
 #include "SceneManagement.h"
-#include "Components/LineBatchComponent.h"
 
-// SceneProxy for UFICToolsContextRenderComponent. Just uses the PDI's available in GetDynamicMeshElements
-// to draw the lines/points accumulated by the Component.
+// chunks of lines/points that changed since the last submit, sent from the game thread to the SceneProxy
+struct FToolsContextRenderGeometryUpdate
+{
+	int32 NumLineChunks = 0;
+	int32 NumPointChunks = 0;
+	TArray<TPair<int32, TArray<UFICToolsContextRenderComponent::FPDILine>>> LineChunks;
+	TArray<TPair<int32, TArray<UFICToolsContextRenderComponent::FPDIPoint>>> PointChunks;
+};
+
+// SceneProxy for UFICToolsContextRenderComponent. Keeps the geometry submitted by the Component
+// and uses the PDI's available in GetDynamicMeshElements to draw it.
 class FToolsContextRenderComponentSceneProxy final : public FPrimitiveSceneProxy
 {
 public:
@@ -16,35 +24,67 @@ public:
 		return reinterpret_cast<size_t>(&UniquePointer);
 	}
 
-	FToolsContextRenderComponentSceneProxy(
-		const UFICToolsContextRenderComponent* InComponent,
-		TUniqueFunction<void(TArray<UFICToolsContextRenderComponent::FPDILine>&, TArray<UFICToolsContextRenderComponent::FPDIPoint>&)>&& GeometryQueryFunc)
+	FToolsContextRenderComponentSceneProxy(const UFICToolsContextRenderComponent* InComponent)
 		: FPrimitiveSceneProxy(InComponent)
 	{
-		GetGeometryQueryFunc = MoveTemp(GeometryQueryFunc);
 	}
 
-	virtual void GetDynamicMeshElements(const TArray<const FSceneView*>& Views, const FSceneViewFamily& ViewFamily, uint32 VisibilityMap, FMeshElementCollector& Collector) const override
+	// called on the rendering thread, replaces the changed chunks
+	void ApplyGeometryUpdate(FToolsContextRenderGeometryUpdate& Update)
 	{
-		TArray<UFICToolsContextRenderComponent::FPDILine> Lines;
-		TArray<UFICToolsContextRenderComponent::FPDIPoint> Points;
-		GetGeometryQueryFunc(Lines, Points);
+		check(IsInRenderingThread());
+		LineChunks.SetNum(Update.NumLineChunks);
+		PointChunks.SetNum(Update.NumPointChunks);
+		for (TPair<int32, TArray<UFICToolsContextRenderComponent::FPDILine>>& Chunk : Update.LineChunks)
+		{
+			LineChunks[Chunk.Key] = MoveTemp(Chunk.Value);
+		}
+		for (TPair<int32, TArray<UFICToolsContextRenderComponent::FPDIPoint>>& Chunk : Update.PointChunks)
+		{
+			PointChunks[Chunk.Key] = MoveTemp(Chunk.Value);
+		}
 
+		FMemory::Memzero(NumThinLines);
+		FMemory::Memzero(NumThickLines);
+		for (const TArray<UFICToolsContextRenderComponent::FPDILine>& Chunk : LineChunks)
+		{
+			for (const UFICToolsContextRenderComponent::FPDILine& Line : Chunk)
+			{
+				int32 Group = FMath::Min<int32>(Line.DepthPriorityGroup, SDPG_MAX - 1);
+				if (Line.Thickness > 0.0f) ++NumThickLines[Group];
+				else ++NumThinLines[Group];
+			}
+		}
+	}
+
+	virtual void GetDynamicMeshElements(const TArray<const FSceneView*>& Views, const FSceneViewFamily& ViewFamily, uint32 VisibilityMap, FMeshElementCollector& Collector) const override
+	{
 		for (int32 ViewIndex = 0; ViewIndex < Views.Num(); ViewIndex++)
 		{
 			if (VisibilityMap & (1 << ViewIndex))
 			{
-				const FSceneView* View = Views[ViewIndex];
 				FPrimitiveDrawInterface* PDI = Collector.GetPDI(ViewIndex);
 
-				int32 NumLines = Lines.Num(), NumPoints = Points.Num();
-				for (int32 k = 0; k < NumLines; ++k)
+				// all lines of a depth priority group end up in one batched element, reserve it at once
+				for (int32 Group = 0; Group < SDPG_MAX; ++Group)
 				{
-					PDI->DrawLine(Lines[k].Start, Lines[k].End, Lines[k].Color, Lines[k].DepthPriorityGroup, Lines[k].Thickness, Lines[k].DepthBias, Lines[k].bScreenSpace);
+					if (NumThinLines[Group] > 0) PDI->AddReserveLines(Group, NumThinLines[Group], false, false);
+					if (NumThickLines[Group] > 0) PDI->AddReserveLines(Group, NumThickLines[Group], false, true);
 				}
-				for (int32 k = 0; k < NumPoints; ++k)
+
+				for (const TArray<UFICToolsContextRenderComponent::FPDILine>& Chunk : LineChunks)
+				{
+					for (const UFICToolsContextRenderComponent::FPDILine& Line : Chunk)
+					{
+						PDI->DrawLine(Line.Start, Line.End, Line.Color, Line.DepthPriorityGroup, Line.Thickness, Line.DepthBias, Line.bScreenSpace);
+					}
+				}
+				for (const TArray<UFICToolsContextRenderComponent::FPDIPoint>& Chunk : PointChunks)
 				{
-					PDI->DrawPoint(Points[k].Position, Points[k].Color, Points[k].PointSize, Points[k].DepthPriorityGroup);
+					for (const UFICToolsContextRenderComponent::FPDIPoint& Point : Chunk)
+					{
+						PDI->DrawPoint(Point.Position, Point.Color, Point.PointSize, Point.DepthPriorityGroup);
+					}
 				}
 			}
 		}
@@ -67,14 +107,62 @@ public:
 	//}
 
 	virtual uint32 GetMemoryFootprint(void) const override { return sizeof * this + GetAllocatedSize(); }
-	uint32 GetAllocatedSize(void) const { return FPrimitiveSceneProxy::GetAllocatedSize(); }
-
+	uint32 GetAllocatedSize(void) const
+	{
+		uint32 Size = FPrimitiveSceneProxy::GetAllocatedSize() + LineChunks.GetAllocatedSize() + PointChunks.GetAllocatedSize();
+		for (const TArray<UFICToolsContextRenderComponent::FPDILine>& Chunk : LineChunks) Size += Chunk.GetAllocatedSize();
+		for (const TArray<UFICToolsContextRenderComponent::FPDIPoint>& Chunk : PointChunks) Size += Chunk.GetAllocatedSize();
+		return Size;
+	}
 
-	// set to lambda that steals current lines/points from the Component
-	TUniqueFunction<void(TArray<UFICToolsContextRenderComponent::FPDILine>&, TArray<UFICToolsContextRenderComponent::FPDIPoint>&)> GetGeometryQueryFunc;
+private:
+	// geometry as submitted by the Component, only accessed on the rendering thread
+	TArray<TArray<UFICToolsContextRenderComponent::FPDILine>> LineChunks;
+	TArray<TArray<UFICToolsContextRenderComponent::FPDIPoint>> PointChunks;
+	int32 NumThinLines[SDPG_MAX] = {};
+	int32 NumThickLines[SDPG_MAX] = {};
 };
 
+static uint32 HashPDIElement(const UFICToolsContextRenderComponent::FPDILine& Line)
+{
+	uint32 Hash = HashCombine(GetTypeHash(Line.Start), GetTypeHash(Line.End));
+	Hash = HashCombine(Hash, GetTypeHash(Line.Color));
+	Hash = HashCombine(Hash, GetTypeHash(Line.Thickness));
+	Hash = HashCombine(Hash, GetTypeHash(Line.DepthBias));
+	return HashCombine(Hash, Line.DepthPriorityGroup | (Line.bScreenSpace ? 0x100 : 0));
+}
+
+static uint32 HashPDIElement(const UFICToolsContextRenderComponent::FPDIPoint& Point)
+{
+	uint32 Hash = HashCombine(GetTypeHash(Point.Position), GetTypeHash(Point.Color));
+	Hash = HashCombine(Hash, GetTypeHash(Point.PointSize));
+	return HashCombine(Hash, Point.DepthPriorityGroup);
+}
 
+// splits the elements into chunks and adds the chunks that differ from the given hashes to the update
+template<typename ElementType>
+static int32 CollectChangedChunks(const TArray<ElementType>& Elements, TArray<uint32>& InOutHashes, TArray<TPair<int32, TArray<ElementType>>>& OutChunks)
+{
+	const int32 ChunkSize = UFICToolsContextRenderComponent::GeometryChunkSize;
+	int32 NumChunks = FMath::DivideAndRoundUp(Elements.Num(), ChunkSize);
+	InOutHashes.SetNum(NumChunks);
+	for (int32 ChunkIndex = 0; ChunkIndex < NumChunks; ++ChunkIndex)
+	{
+		int32 Begin = ChunkIndex * ChunkSize;
+		int32 Num = FMath::Min(ChunkSize, Elements.Num() - Begin);
+		uint32 Hash = Num;
+		for (int32 i = Begin; i < Begin + Num; ++i)
+		{
+			Hash = HashCombine(Hash, HashPDIElement(Elements[i]));
+		}
+		// zero marks chunks the proxy doesn't have yet
+		Hash = FMath::Max(Hash, 1u);
+		if (InOutHashes[ChunkIndex] == Hash) continue;
+		InOutHashes[ChunkIndex] = Hash;
+		OutChunks.Emplace(ChunkIndex, TArray<ElementType>(Elements.GetData() + Begin, Num));
+	}
+	return NumChunks;
+}
 
 // implementation of FPrimitiveDrawInterface that forwards DrawLine/DrawPoint calls to
 // a UFICToolsContextRenderComponent instance. No other PDI functionality is implemented.
@@ -84,14 +172,10 @@ class FToolsContextRenderComponentPDI : public FPrimitiveDrawInterface
 {
 public:
 	UFICToolsContextRenderComponent* RenderComponent = nullptr;
-	ULineBatchComponent* LineBatchComponent = nullptr;
 
 	FToolsContextRenderComponentPDI(const FSceneView* InView, UFICToolsContextRenderComponent* RenderComponentIn) : FPrimitiveDrawInterface(InView) {
 		RenderComponent = RenderComponentIn;
 	}
-	FToolsContextRenderComponentPDI(const FSceneView* InView, ULineBatchComponent* LineBatchComponentIn) : FPrimitiveDrawInterface(InView) {
-		LineBatchComponent = LineBatchComponentIn;
-	}
 
 	virtual bool IsHitTesting() { return false; }
 	virtual void SetHitProxy(HHitProxy* HitProxy) { };
@@ -107,13 +191,11 @@ public:
 		uint8 DepthPriorityGroup, float Thickness = 0.0f, float DepthBias = 0.0f, bool bScreenSpace = false	)
 	{
 		if (RenderComponent) RenderComponent->DrawLine(Start, End, Color, DepthPriorityGroup, Thickness, DepthBias, bScreenSpace);
-		if (LineBatchComponent) LineBatchComponent->DrawLine(Start, End, Color, DepthPriorityGroup, Thickness);
 	}
 
 	virtual void DrawPoint( const FVector& Position, const FLinearColor& Color, float PointSize, uint8 DepthPriorityGroup )
 	{
 		if (RenderComponent) RenderComponent->DrawPoint(Position, Color, PointSize, DepthPriorityGroup);
-		if (LineBatchComponent) LineBatchComponent->DrawPoint(Position, Color, PointSize, DepthPriorityGroup);
 	}
 
 };
@@ -124,10 +206,6 @@ TSharedPtr<FPrimitiveDrawInterface> UFICToolsContextRenderComponent::GetPDIForVi
 	return MakeShared<FToolsContextRenderComponentPDI>(InView, this);
 }
 
-TSharedPtr<FPrimitiveDrawInterface> UFICToolsContextRenderComponent::GetPDIForView(const FSceneView* InView, ULineBatchComponent* LineBatchComponent) {
-	return MakeShared<FToolsContextRenderComponentPDI>(InView, LineBatchComponent);
-}
-
 void UFICToolsContextRenderComponent::DrawLine(
 	const FVector& Start,
 	const FVector& End,
@@ -138,10 +216,8 @@ void UFICToolsContextRenderComponent::DrawLine(
 	bool bScreenSpace
 )
 {
-	GeometryLock.Lock();
 	CurrentLines.Add(
 		FPDILine{ Start, End, Color, DepthPriorityGroupIn, Thickness, DepthBias, bScreenSpace });
-	GeometryLock.Unlock();
 }
 
 void UFICToolsContextRenderComponent::DrawPoint(
@@ -151,27 +227,40 @@ void UFICToolsContextRenderComponent::DrawPoint(
 	uint8 DepthPriorityGroupIn
 )
 {
-	GeometryLock.Lock();
 	CurrentPoints.Add(
 		FPDIPoint{ Position, Color, PointSize, DepthPriorityGroupIn });
-	GeometryLock.Unlock();
 }
 
-
-TUniqueFunction<void(TArray<UFICToolsContextRenderComponent::FPDILine>&, TArray<UFICToolsContextRenderComponent::FPDIPoint>&)> UFICToolsContextRenderComponent::MakeGetCurrentGeometryQueryFunc()
+void UFICToolsContextRenderComponent::SubmitGeometry()
 {
-	return [this](TArray<FPDILine>& LineStorage, TArray<FPDIPoint>& PointStorage)
+	FToolsContextRenderComponentSceneProxy* Proxy = static_cast<FToolsContextRenderComponentSceneProxy*>(SceneProxy);
+	if (Proxy)
 	{
-		GeometryLock.Lock();
-		LineStorage = MoveTemp(CurrentLines);
-		PointStorage = MoveTemp(CurrentPoints);
-		GeometryLock.Unlock();
-	};
+		FToolsContextRenderGeometryUpdate Update;
+		Update.NumLineChunks = CollectChangedChunks(CurrentLines, SubmittedLineChunkHashes, Update.LineChunks);
+		Update.NumPointChunks = CollectChangedChunks(CurrentPoints, SubmittedPointChunkHashes, Update.PointChunks);
+		bool bChunkCountChanged = Update.NumLineChunks != LastSubmittedLineChunks || Update.NumPointChunks != LastSubmittedPointChunks;
+		LastSubmittedLineChunks = Update.NumLineChunks;
+		LastSubmittedPointChunks = Update.NumPointChunks;
+		if (bChunkCountChanged || Update.LineChunks.Num() > 0 || Update.PointChunks.Num() > 0)
+		{
+			ENQUEUE_RENDER_COMMAND(FICToolsContextRenderGeometryUpdate)([Proxy, Update = MoveTemp(Update)](FRHICommandListImmediate& RHICmdList) mutable
+			{
+				Proxy->ApplyGeometryUpdate(Update);
+			});
+		}
+	}
+	
+	CurrentLines.Reset();
+	CurrentPoints.Reset();
 }
 
 FPrimitiveSceneProxy* UFICToolsContextRenderComponent::CreateSceneProxy() {
-	return Super::CreateSceneProxy();
-	return new FToolsContextRenderComponentSceneProxy(this, MakeGetCurrentGeometryQueryFunc());
+	// the new proxy has no geometry yet, so everything has to be submitted again
+	SubmittedLineChunkHashes.Empty();
+	SubmittedPointChunkHashes.Empty();
+	LastSubmittedLineChunks = LastSubmittedPointChunks = 0;
+	return new FToolsContextRenderComponentSceneProxy(this);
 }
 
 bool UFICToolsContextRenderComponent::LineTraceComponent(FHitResult& OutHit, const FVector Start, const FVector End, const FCollisionQueryParams& Params)
@@ -93,7 +93,7 @@ void FFICGraphKeyframeDragDrop::OnDragged(const FDragDropEvent& DragDropEvent) {
 			Movement.Key->MoveKeyframe(Movement.Value[Index], Movement.Value[Index] + CumulativeTimelineDiff);
 			Selection.Add(TPair<FFICAttribute*, FICFrame>(Movement.Key, Movement.Value[Index] + CumulativeTimelineDiff));
 		}
-		Movement.Key->RecalculateAllKeyframes();
+		Movement.Key->RecalculateDirtyKeyframes();
 		Movement.Key->UnlockUpdateEvent();
 	}
 	GraphView->SetSelection(Selection);
@@ -219,7 +219,7 @@ void FFICSequencerKeyframeDragDrop::OnDragged(const FDragDropEvent& DragDropEven
 	double start3 = FPlatformTime::Seconds();
 	Attribute->MoveKeyframe(Frame, Frame + CumulativeTimeDiff);
 	double start4 = FPlatformTime::Seconds();
-	Attribute->RecalculateAllKeyframes();
+	Attribute->RecalculateDirtyKeyframes();
 	double start5 = FPlatformTime::Seconds();
 	Attribute->UnlockUpdateEvent();
 	double start6 = FPlatformTime::Seconds();
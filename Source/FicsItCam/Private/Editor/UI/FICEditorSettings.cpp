@@ -2,6 +2,7 @@
 
 #include "FICUtils.h"
 #include "Editor/FICEditorContext.h"
+#include "Widgets/Input/SNumericEntryBox.h"
 
 void SFICEditorSettings::Construct(const FArguments& InArgs, UFICEditorContext* InContext) {
 	Context = InContext;
@@ -64,5 +65,36 @@ void SFICEditorSettings::Construct(const FArguments& InArgs, UFICEditorContext*
 			})
 			.ToolTipText(FText::FromString(FString::Printf(TEXT("If enabled, a small camera preview will be shown in the viewport when a camera is selected."))))
 		]
+		+SScrollBox::Slot().Padding(5)[
+			SNew(STextBlock)
+			.Text_Lambda([this]() {
+				const FFICChangeList& ChangeList = Context->ChangeList;
+				return FText::FromString(FString::Printf(TEXT("Undo History: %i Changes, %.2f / %.0f MB"), ChangeList.Num(), ChangeList.GetMemoryUsage() / (1024.0f * 1024.0f), ChangeList.GetMemoryBudget() / (1024.0f * 1024.0f)));
+			})
+			.ToolTipText(FText::FromString(TEXT("Approximate memory used by the undo history, the oldest changes get dropped when the budget is exceeded.")))
+		]
+		+SScrollBox::Slot().Padding(5).HAlign(HAlign_Fill)[
+			SNew(SHorizontalBox)
+			.ToolTipText(FText::FromString(TEXT("Memory budget of the undo history, lowering it immediately drops the oldest changes that exceed it.")))
+			+SHorizontalBox::Slot().AutoWidth()[
+				SNew(STextBlock).Text(FText::FromString("Undo History Budget (MB): "))
+			]
+			+SHorizontalBox::Slot().FillWidth(1)[
+				SNew(SNumericEntryBox<int>)
+				.Value_Lambda([this]() {
+					return (int)(Context->ChangeList.GetMemoryBudget() / (1024 * 1024));
+				})
+				.SupportDynamicSliderMaxValue(true)
+				.SliderExponent(1)
+				.Delta(1)
+				.MinValue(1)
+				.LinearDeltaSensitivity(10)
+				.AllowSpin(false)
+				.OnValueCommitted_Lambda([this](int Val, auto) {
+					Context->ChangeList.SetMemoryBudget((SIZE_T)FMath::Max(1, Val) * 1024 * 1024);
+				})
+				.TypeInterface(MakeShared<TDefaultNumericTypeInterface<int>>())
+			]
+		]
 	];
 }
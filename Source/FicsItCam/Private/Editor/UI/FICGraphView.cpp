@@ -217,7 +217,7 @@ FReply SFICGraphViewKeyframe::OnMouseButtonUp(const FGeometry& MyGeometry, const
 				TSharedRef<FFICKeyframe>* NKF = KFS.Find(KF.Value);
 				if (NKF) (*NKF)->SetType(Type);
 				KF.Key->LockUpdateEvent();
-				KF.Key->RecalculateAllKeyframes();
+				KF.Key->RecalculateDirtyKeyframes();
 				KF.Key->UnlockUpdateEvent(false);
 			}
 			for (const TPair<FFICAttribute*, TSharedRef<FFICAttribute>>& Snapshot : Snapshots) {
@@ -284,6 +284,7 @@ void SFICGraphView::Construct(const FArguments& InArgs, UFICEditorContext* InCon
 	OnFrameRangeChanged = InArgs._OnFrameRangeChanged;
 	OnValueRangeChanged = InArgs._OnValueRangeChanged;
 	Context = InContext;
+	if (Context) Context->OnAttributesUpdated.AddSP(this, &SFICGraphView::OnAttributesUpdated);
 
 	SetAttributes(InArgs._Attributes);
 	Update();
@@ -298,11 +299,7 @@ SFICGraphView::SFICGraphView() : Children(this) {
 	BoxSelection.bIsValid = false;
 }
 
-SFICGraphView::~SFICGraphView() {
-	for (TSharedRef<FFICEditorAttributeBase> Attribute : Attributes) {
-		Attribute->GetAttribute().OnUpdate.Remove(DelegateHandles[Attribute]);
-	}
-}
+SFICGraphView::~SFICGraphView() {}
 
 FVector2D SFICGraphView::ComputeDesiredSize(float) const {
 	return FVector2D(0, 0);
@@ -397,7 +394,7 @@ FReply SFICGraphView::OnMouseButtonUp(const FGeometry& MyGeometry, const FPointe
 				if (Difference.Size() < 5) {
 					BEGIN_QUICK_ATTRIB_CHANGE(Context, Attribute->GetAttribute(), TNumericLimits<int64>::Min(), Frame)
 					Attribute->SetKeyframe(FFICValueTime(Frame, LocalToValue(LocalMousePos.Y)));
-					Attribute->GetAttribute().RecalculateAllKeyframes();
+					Attribute->GetAttribute().RecalculateDirtyKeyframes();
 					END_QUICK_ATTRIB_CHANGE(Context->ChangeList)
 					return FReply::Handled();
 				}
@@ -498,7 +495,9 @@ void SFICGraphView::OnArrangeChildren(const FGeometry& AllottedGeometry, FArrang
 	for (int ChildIndex = 0; ChildIndex < Children.Num(); ++ChildIndex) {
 		TSharedRef<SFICGraphViewKeyframe> Child = Children[ChildIndex];
 		float Frame = FrameToLocal(Child->GetFrame());
-		float Value = ValueToLocal(Child->GetKeyframe()->GetValue());
+		TSharedPtr<FFICKeyframe> Keyframe = Child->GetKeyframe();
+		if (!Keyframe) continue;
+		float Value = ValueToLocal(Keyframe->GetValue());
 		ArrangedChildren.AddWidget(AllottedGeometry.MakeChild(Child, FVector2D(Frame, Value), Child->GetDesiredSize(), 1));
 	}
 }
@@ -579,15 +578,7 @@ void SFICGraphView::SetBoxSelection(FBox2D InBox, const FModifierKeysState& InMo
 }
 
 void SFICGraphView::SetAttributes(const TArray<TSharedRef<FFICEditorAttributeBase>>& InAttributes) {
-	for (TSharedRef<FFICEditorAttributeBase> Attribute : Attributes) {
-		Attribute->GetAttribute().OnUpdate.Remove(DelegateHandles[Attribute]);
-	}
-	
 	Attributes = InAttributes;
-
-	for (TSharedRef<FFICEditorAttributeBase> Attribute : Attributes) {
-		DelegateHandles.Add(Attribute, Attribute->GetAttribute().OnUpdate.AddSP(this, &SFICGraphView::Update));
-	}
 	
 	Update();
 }
@@ -603,6 +594,15 @@ void SFICGraphView::Update() {
 	}
 }
 
+void SFICGraphView::OnAttributesUpdated(const TSet<FFICAttribute*>& UpdatedAttributes) {
+	for (TSharedRef<FFICEditorAttributeBase> Attribute : Attributes) {
+		if (UpdatedAttributes.Contains(&Attribute->GetAttribute())) {
+			Update();
+			return;
+		}
+	}
+}
+
 void SFICGraphView::FitAll() {
 	FFICFrameRange Frames = FrameHighlightRange.Get();
 	FFICValueRange Values;
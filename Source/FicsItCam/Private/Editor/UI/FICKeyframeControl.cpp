@@ -97,7 +97,7 @@ FReply SFICKeyframeControl::OnMouseButtonUp(const FGeometry& MyGeometry, const F
 		BEGIN_QUICK_ATTRIB_CHANGE(Context, Attrib, GetFrame(), GetFrame())
 		if (Attribute->GetKeyframe(GetFrame()) && (!Attribute->HasChanged(GetFrame()))) Attribute->RemoveKeyframe(GetFrame());
 		else Attribute->SetKeyframe(GetFrame());
-		Attrib.RecalculateAllKeyframes();
+		Attrib.RecalculateDirtyKeyframes();
 		END_QUICK_ATTRIB_CHANGE(Context->ChangeList)
 		Attrib.UnlockUpdateEvent();
 		return FReply::Handled();
@@ -113,7 +113,7 @@ FReply SFICKeyframeControl::OnMouseButtonUp(const FGeometry& MyGeometry, const F
                 FUIAction(FExecuteAction::CreateLambda([KF, this]() {
                 	BEGIN_QUICK_ATTRIB_CHANGE(Context, Attribute->GetAttribute(), GetFrame(), GetFrame())
                     KF->SetType(FIC_KF_EASE);
-                	Attribute->GetAttribute().RecalculateAllKeyframes();
+                	Attribute->GetAttribute().RecalculateDirtyKeyframes();
                 	END_QUICK_ATTRIB_CHANGE(Context->ChangeList)
                 }), FCanExecuteAction::CreateRaw(&FSlateApplication::Get(), &FSlateApplication::IsNormalExecution)));
 			MenuBuilder.AddMenuEntry(
@@ -123,7 +123,7 @@ FReply SFICKeyframeControl::OnMouseButtonUp(const FGeometry& MyGeometry, const F
                 FUIAction(FExecuteAction::CreateLambda([KF, this]() {
                 	BEGIN_QUICK_ATTRIB_CHANGE(Context, Attribute->GetAttribute(), GetFrame(), GetFrame())
                     KF->SetType(FIC_KF_EASEINOUT);
-                	Attribute->GetAttribute().RecalculateAllKeyframes();
+                	Attribute->GetAttribute().RecalculateDirtyKeyframes();
                 	END_QUICK_ATTRIB_CHANGE(Context->ChangeList)
                 }), FCanExecuteAction::CreateRaw(&FSlateApplication::Get(), &FSlateApplication::IsNormalExecution)));
 			MenuBuilder.AddMenuEntry(
@@ -133,7 +133,7 @@ FReply SFICKeyframeControl::OnMouseButtonUp(const FGeometry& MyGeometry, const F
                 FUIAction(FExecuteAction::CreateLambda([KF, this]() {
                 	BEGIN_QUICK_ATTRIB_CHANGE(Context, Attribute->GetAttribute(), GetFrame(), GetFrame())
                     KF->SetType(FIC_KF_LINEAR);
-                	Attribute->GetAttribute().RecalculateAllKeyframes();
+                	Attribute->GetAttribute().RecalculateDirtyKeyframes();
                 	END_QUICK_ATTRIB_CHANGE(Context->ChangeList)
                 }), FCanExecuteAction::CreateRaw(&FSlateApplication::Get(), &FSlateApplication::IsNormalExecution)));
 			MenuBuilder.AddMenuEntry(
@@ -143,7 +143,7 @@ FReply SFICKeyframeControl::OnMouseButtonUp(const FGeometry& MyGeometry, const F
                 FUIAction(FExecuteAction::CreateLambda([KF, this]() {
                 	BEGIN_QUICK_ATTRIB_CHANGE(Context, Attribute->GetAttribute(), GetFrame(), GetFrame())
                     KF->SetType(FIC_KF_STEP);
-                	Attribute->GetAttribute().RecalculateAllKeyframes();
+                	Attribute->GetAttribute().RecalculateDirtyKeyframes();
                 	END_QUICK_ATTRIB_CHANGE(Context->ChangeList)
                 }), FCanExecuteAction::CreateRaw(&FSlateApplication::Get(), &FSlateApplication::IsNormalExecution)));
 		
@@ -25,7 +25,7 @@ void SFICSceneObjectOutlinerRow::Construct(const FArguments& InArgs, UFICEditorC
 				.OnTextCommitted_Lambda([this](const FText& Text, ETextCommit::Type Type) {
 					FString Name = Text.ToString();
 					if (UFICUtils::IsValidFICObjectName(Name)) {
-						Cast<IFICSceneObject>(SceneObject)->SetSceneObjectName(UFICUtils::AdjustSceneObjectName(Context->GetScene(), Name));
+						Context->GetScene()->RenameSceneObject(SceneObject, UFICUtils::AdjustSceneObjectName(Context->GetScene(), Name));
 					}
 				})
 				.Text_Lambda([this]() {
@@ -41,6 +41,17 @@ void SFICSceneSettings::Construct(const FArguments& InArgs, UFICEditorContext* I
 			})
 			.ToolTipText(FText::FromString(TEXT("If enabled, animation will restart automatically at the end of the animation sequence.")))
 		]
+		+SScrollBox::Slot().Padding(5)[
+			SNew(SCheckBox)
+			.Content()[SNew(STextBlock).Text(FText::FromString("Multi Camera Render"))]
+			.IsChecked_Lambda([this]() {
+				return Context->GetScene()->bMultiCameraRender ? ECheckBoxState::Checked : ECheckBoxState::Unchecked;
+			})
+			.OnCheckStateChanged_Lambda([this](ECheckBoxState State) {
+				Context->GetScene()->bMultiCameraRender = State == ECheckBoxState::Checked;
+			})
+			.ToolTipText(FText::FromString(TEXT("If enabled, rendering the scene additionally captures every camera marked as render output into its own image sequence.")))
+		]
 		+SScrollBox::Slot().Padding(5).HAlign(HAlign_Fill)[
 			SNew(SHorizontalBox)
 			+SHorizontalBox::Slot().AutoWidth()[
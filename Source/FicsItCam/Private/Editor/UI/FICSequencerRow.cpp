@@ -1,5 +1,5 @@
 ﻿#include "Editor/UI/FICSequencerRow.h"
-
+#include "Editor/FICEditorContext.h"
 #include "Editor/UI/FICDragDrop.h"
 #include "Editor/UI/FICKeyframeIcon.h"
 #include "Editor/UI/FICSequencer.h"
@@ -119,7 +119,7 @@ void SFICSequencerRowAttribute::Construct(const FArguments& InArgs, SFICSequence
 	
 	Attribute = InAttribute;
 	
-	DelegateHandle = Attribute->GetAttribute().OnUpdate.AddSP(SharedThis(this), &SFICSequencerRowAttribute::UpdateKeyframes);
+	if (Context) Context->OnAttributesUpdated.AddSP(SharedThis(this), &SFICSequencerRowAttribute::OnAttributesUpdated);
 
 	UpdateKeyframes();
 }
@@ -128,9 +128,7 @@ SFICSequencerRowAttribute::SFICSequencerRowAttribute() : Children(this) {
 	//TestColor = FLinearColor::MakeRandomColor();
 }
 
-SFICSequencerRowAttribute::~SFICSequencerRowAttribute() {
-	Attribute->GetAttribute().OnUpdate.Remove(DelegateHandle);
-}
+SFICSequencerRowAttribute::~SFICSequencerRowAttribute() {}
 
 FVector2D SFICSequencerRowAttribute::ComputeDesiredSize(float) const {
 	return FVector2D(1, 1);
@@ -169,6 +167,10 @@ void SFICSequencerRowAttribute::UpdateKeyframes() {
 	}
 }
 
+void SFICSequencerRowAttribute::OnAttributesUpdated(const TSet<FFICAttribute*>& UpdatedAttributes) {
+	if (UpdatedAttributes.Contains(&Attribute->GetAttribute())) UpdateKeyframes();
+}
+
 FFICAttribute* SFICSequencerRowAttribute::GetAttribute() const {
 	return &Attribute->GetAttribute();
 }
@@ -1,5 +1,6 @@
 ﻿#include "FICSubsystem.h"
 
+#include "FICStats.h"
 #include "IImageWrapper.h"
 #include "IImageWrapperModule.h"
 #include "Command/FICCommand.h"
@@ -10,15 +11,90 @@
 #include "Runtime/FICRuntimeProcessorCharacter.h"
 #include "Runtime/FICTimelapseCamera.h"
 #include "Runtime/Process/FICRuntimeProcess.h"
+#include "Runtime/Process/FICRuntimeProcessCameraFeed.h"
 #include "Runtime/Process/FICRuntimeProcessTimelapseCamera.h"
 
-FFICAsyncImageCompressAndSave::FFICAsyncImageCompressAndSave(TSharedPtr<IImageWrapper> Image, FString Path) : Image(Image), Path(Path) {}
+DECLARE_CYCLE_STAT(TEXT("Render Request Readback"), STAT_FICRenderRequestReadback, STATGROUP_FicsItCam);
+DECLARE_CYCLE_STAT(TEXT("Runtime Processes Tick"), STAT_FICRuntimeProcessesTick, STATGROUP_FicsItCam);
+DECLARE_CYCLE_STAT(TEXT("Timelapse Captures Tick"), STAT_FICTimelapseCapturesTick, STATGROUP_FicsItCam);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Pending Render Requests"), STAT_FICPendingRenderRequests, STATGROUP_FicsItCam);
+
+TSharedRef<FRHIGPUTextureReadback> FFICReadbackPool::Acquire() {
+	if (FreeReadbacks.Num() > 0) return FreeReadbacks.Pop(false);
+	return MakeShared<FRHIGPUTextureReadback>(Name);
+}
+
+void FFICReadbackPool::Release(TSharedPtr<FRHIGPUTextureReadback> Readback) {
+	if (Readback && FreeReadbacks.Num() < MaxFreeReadbacks) FreeReadbacks.Push(Readback.ToSharedRef());
+}
+
+bool FFICRenderRequest::IsReady() const {
+	if (!RenderFence.IsFenceComplete()) return false;
+	if (!Readback->IsReady()) return false;
+	if (ProxyReadbackSize != FIntPoint::ZeroValue && !ProxyReadback->IsReady()) return false;
+	return true;
+}
+
+static FFICImageData ReadbackToImage(FRHIGPUTextureReadback& Readback, FIntPoint Size, bool bBGRA) {
+	// the lock doesn't expose the row pitch, the rows are only tightly packed because the GPU conversion aligns every readback width
+	ensure(!FFICImageProcessing::SupportsGPUConversion() || Size.X % FFICImageOutputSettings::WidthAlignment == 0);
+	FFICImageData Image;
+	Image.Size = Size;
+	Image.bBGRA = bBGRA;
+	int64 RawSize = (int64)Size.X * Size.Y * sizeof(FColor);
+	Image.Pixels.SetNumUninitialized(RawSize);
+	FMemory::Memcpy(Image.Pixels.GetData(), Readback.Lock(RawSize), RawSize);
+	Readback.Unlock();
+	return Image;
+}
+
+FFICAsyncImageCompressAndSave::FFICAsyncImageCompressAndSave(FFICImageData&& Image, FFICImageData&& Proxy, const FFICImageOutputSettings& Settings, TSharedPtr<IImageWrapper> ImageWrapper, TSharedPtr<IImageWrapper> ProxyWrapper, TArray<FFICImageOutput> Outputs) : Image(MoveTemp(Image)), Proxy(MoveTemp(Proxy)), Settings(Settings), ImageWrapper(ImageWrapper), ProxyWrapper(ProxyWrapper), Outputs(MoveTemp(Outputs)) {}
 
 FFICAsyncImageCompressAndSave::~FFICAsyncImageCompressAndSave() {}
 
+void FFICAsyncImageCompressAndSave::SaveImage(const FFICImageData& InImage, TSharedPtr<IImageWrapper> InWrapper, const TArray<FString>& InPaths) {
+	if (Settings.Format == EFICImageFormat::YUV420) {
+		TArray64<uint8> Planes;
+		FFICImageProcessing::ConvertToYUV420(InImage.Pixels, InImage.Size, InImage.bBGRA, Planes);
+		for (const FString& InPath : InPaths) FFileHelper::SaveArrayToFile(Planes, *FPaths::ChangeExtension(InPath, TEXT("yuv")));
+	} else if (Settings.Format == EFICImageFormat::BGRA) {
+		// raw 8-bit BGRA pixels without header, for tools that consume the swizzled layout directly
+		for (const FString& InPath : InPaths) FFileHelper::SaveArrayToFile(InImage.Pixels, *FPaths::ChangeExtension(InPath, TEXT("bgra")));
+	} else {
+		if (!InWrapper->SetRaw(InImage.Pixels.GetData(), InImage.Pixels.Num(), InImage.Size.X, InImage.Size.Y, InImage.bBGRA ? ERGBFormat::BGRA : ERGBFormat::RGBA, 8)) return;
+		TArray64<uint8> CompressedData = InWrapper->GetCompressed(100);
+		for (const FString& InPath : InPaths) FFileHelper::SaveArrayToFile(CompressedData, *InPath);
+	}
+}
+
 void FFICAsyncImageCompressAndSave::DoWork() {
-	TArray64<uint8> CompressedData = Image->GetCompressed(100);
-	FFileHelper::SaveArrayToFile(CompressedData, *Path);
+	TArray<FString> Paths;
+	for (const FFICImageOutput& Output : Outputs) Paths.Add(Output.Path);
+	
+	// CPU reference path for every conversion the render thread didn't already do
+	FIntPoint OutputSize = Settings.GetOutputSize(Image.Size);
+	if (Image.Size != OutputSize) {
+		TArray64<uint8> Resampled;
+		FFICImageProcessing::Resample(Image.Pixels, Image.Size, Resampled, OutputSize);
+		Image.Pixels = MoveTemp(Resampled);
+		Image.Size = OutputSize;
+	}
+	if (Settings.Format == EFICImageFormat::BGRA && !Image.bBGRA) {
+		FFICImageProcessing::SwizzleRedBlue(Image.Pixels);
+		Image.bBGRA = true;
+	}
+
+	SaveImage(Image, ImageWrapper, Paths);
+
+	if (Settings.bWriteProxy) {
+		if (Proxy.Pixels.Num() < 1) {
+			Proxy.Size = Settings.GetProxySize(Image.Size);
+			Proxy.bBGRA = Image.bBGRA;
+			FFICImageProcessing::Resample(Image.Pixels, Image.Size, Proxy.Pixels, Proxy.Size);
+		}
+		for (FString& Path : Paths) Path = FPaths::GetBaseFilename(Path, false) + TEXT("_proxy") + FPaths::GetExtension(Path, true);
+		SaveImage(Proxy, ProxyWrapper, Paths);
+	}
 }
 
 AFICSubsystem* AFICSubsystem::GetFICSubsystem(UObject* WorldContext) {
@@ -42,6 +118,8 @@ void AFICSubsystem::BeginPlay() {
 		StartRuntimeProcess(Process);
 	}
 
+	RebuildSceneIndex();
+
 	// Convert deprecated AFICAnimation Actors to Scene Actors
 	for (TActorIterator<AFICAnimation> Animation(GetWorld()); Animation; ++Animation) {
 		Animation->CreateScene();
@@ -62,26 +140,111 @@ void AFICSubsystem::Tick(float DeltaSeconds) {
 	if (!RenderRequestQueue.IsEmpty()) {
 		TSharedPtr<FFICRenderRequest> NextRequest = *RenderRequestQueue.Peek();
 		if (NextRequest) {
-			if (NextRequest->RenderFence.IsFenceComplete() && NextRequest->Readback.IsReady()) {
+			if (NextRequest->IsReady()) {
+				SCOPE_CYCLE_COUNTER(STAT_FICRenderRequestReadback);
+				RenderRequestQueue.Pop();
+				DEC_DWORD_STAT(STAT_FICPendingRenderRequests);
+				
+				FFICImageData Image = ReadbackToImage(*NextRequest->Readback, NextRequest->ReadbackSize, NextRequest->bReadbackBGRA);
+				ReadbackPool.Release(NextRequest->Readback);
+
 				IImageWrapperModule& ImageWrapperModule = FModuleManager::LoadModuleChecked<IImageWrapperModule>(FName("ImageWrapper"));
-				TSharedPtr<IImageWrapper> ImageWrapper = ImageWrapperModule.CreateImageWrapper(EImageFormat::JPEG);
+				TSharedPtr<IImageWrapper> ImageWrapper;
+				TSharedPtr<IImageWrapper> ProxyWrapper;
+				if (NextRequest->Settings.Format == EFICImageFormat::RGBA) {
+					ImageWrapper = ImageWrapperModule.CreateImageWrapper(EImageFormat::JPEG);
+					if (NextRequest->Settings.bWriteProxy) ProxyWrapper = ImageWrapperModule.CreateImageWrapper(EImageFormat::JPEG);
+				}
+
+				FFICImageData Proxy;
+				if (NextRequest->ProxyReadbackSize != FIntPoint::ZeroValue) {
+					Proxy = ReadbackToImage(*NextRequest->ProxyReadback, NextRequest->ProxyReadbackSize, NextRequest->bReadbackBGRA);
+				}
+				FFICImageOutputSettings Settings = NextRequest->Settings;
+				Settings.Size = Settings.GetOutputSize(NextRequest->SourceSize);
+
+				TArray<TSharedPtr<FFICImageChangeDetector>> ChangeDetectors;
+				for (const FFICImageOutput& Output : NextRequest->Outputs) {
+					if (Output.ChangeDetector) ChangeDetectors.AddUnique(Output.ChangeDetector);
+				}
+				if (ChangeDetectors.Num() < 1) {
+					(new FAutoDeleteAsyncTask<FFICAsyncImageCompressAndSave>(MoveTemp(Image), MoveTemp(Proxy), Settings, ImageWrapper, ProxyWrapper, NextRequest->Outputs))->StartBackgroundTask();
+				} else {
+					// requests get popped in capture order, the detectors keep that order while deciding in the background
+					FFICImageChangeDetector::QueueDecision(ChangeDetectors, [Image = MoveTemp(Image), Proxy = MoveTemp(Proxy), Settings, ImageWrapper, ProxyWrapper, Outputs = NextRequest->Outputs]() mutable {
+						TArray<FFICImageOutput> StoredOutputs;
+						for (const FFICImageOutput& Output : Outputs) {
+							if (Output.ChangeDetector && !Output.ChangeDetector->ShouldStore(Image.Pixels, Image.Size, Image.bBGRA, Output.Path)) continue;
+							StoredOutputs.Add(Output);
+						}
+						if (StoredOutputs.Num() < 1) return;
+						(new FAutoDeleteAsyncTask<FFICAsyncImageCompressAndSave>(MoveTemp(Image), MoveTemp(Proxy), Settings, ImageWrapper, ProxyWrapper, MoveTemp(StoredOutputs)))->StartBackgroundTask();
+					});
+				}
+				ProxyReadbackPool.Release(NextRequest->ProxyReadback);
+			}
+		}
+	}
 
-				FRenderTarget* Target = NextRequest->RenderTarget->GetRenderTarget();
+	{
+		SCOPE_CYCLE_COUNTER(STAT_FICRuntimeProcessesTick);
+		for (UFICRuntimeProcess* RuntimeProcess : ActiveRuntimeProcesses) {
+			RuntimeProcess->Tick(RuntimeProcess->NeedsRuntimeProcessCharacter() ? GetRuntimeProcessorCharacter() : nullptr, DeltaSeconds);
+		}
+	}
 
-				FIntPoint Size = NextRequest->RenderTarget->GetRenderTarget()->GetSizeXY();
-				int64 RawSize = Size.X * Size.Y * sizeof(FColor);
-				bool bRaw = ImageWrapper->SetRaw(NextRequest->Readback.Lock(RawSize), RawSize, Target->GetSizeXY().X, Target->GetSizeXY().Y, ERGBFormat::RGBA, 8);
-				if (!bRaw) return;
-				RenderRequestQueue.Pop();
-				
-				(new FAutoDeleteAsyncTask<FFICAsyncImageCompressAndSave>(ImageWrapper, NextRequest->Path))->StartBackgroundTask();
+	TickTimelapseCaptures();
+	TickFeedCaptures();
+}
+
+void AFICSubsystem::TickTimelapseCaptures() {
+	SCOPE_CYCLE_COUNTER(STAT_FICTimelapseCapturesTick);
+	// a misconfigured budget must not stall the captures entirely
+	int32 Budget = FMath::Max(MaxTimelapseCapturesPerTick, 1);
+	TSet<UFICRuntimeProcessTimelapseCamera*> Captured;
+	int32 Index = 0;
+	for (; Budget > 0 && Index < PendingTimelapseCaptures.Num(); ++Index) {
+		UFICRuntimeProcessTimelapseCamera* Process = PendingTimelapseCaptures[Index];
+		if (!Process || Captured.Contains(Process) || !ActiveRuntimeProcesses.Contains(Process)) continue;
+		Captured.Add(Process);
+
+		TArray<UFICRuntimeProcessTimelapseCamera*> SharedWith;
+		for (int32 i = Index+1; i < PendingTimelapseCaptures.Num(); ++i) {
+			UFICRuntimeProcessTimelapseCamera* Other = PendingTimelapseCaptures[i];
+			if (Other && !Captured.Contains(Other) && ActiveRuntimeProcesses.Contains(Other) && Process->CanShareCapture(Other)) {
+				SharedWith.Add(Other);
+				Captured.Add(Other);
 			}
 		}
+
+		Process->Capture(SharedWith);
+		--Budget;
 	}
+	if (Index < 1) return;
+
+	// drop the handled captures in a single pass instead of shifting the queue for every capture
+	TArray<UFICRuntimeProcessTimelapseCamera*> Remaining;
+	Remaining.Reserve(PendingTimelapseCaptures.Num() - Index);
+	for (int32 i = Index; i < PendingTimelapseCaptures.Num(); ++i) {
+		UFICRuntimeProcessTimelapseCamera* Process = PendingTimelapseCaptures[i];
+		if (!Captured.Contains(Process)) Remaining.Add(Process);
+	}
+	PendingTimelapseCaptures = MoveTemp(Remaining);
+}
 
-	for (UFICRuntimeProcess* RuntimeProcess : ActiveRuntimeProcesses) {
-		RuntimeProcess->Tick(RuntimeProcess->NeedsRuntimeProcessCharacter() ? GetRuntimeProcessorCharacter() : nullptr, DeltaSeconds);
+void AFICSubsystem::TickFeedCaptures() {
+	// the most overdue feeds go first, so feeds that missed the budget are served in the following ticks
+	DueFeedCaptures.Sort([](const UFICRuntimeProcessCameraFeed& A, const UFICRuntimeProcessCameraFeed& B) {
+		return A.GetCaptureLateness() > B.GetCaptureLateness();
+	});
+	int32 Budget = FMath::Max(MaxFeedCapturesPerTick, 1);
+	for (UFICRuntimeProcessCameraFeed* Feed : DueFeedCaptures) {
+		if (Budget <= 0) break;
+		if (!ActiveRuntimeProcesses.Contains(Feed)) continue;
+		Feed->Capture();
+		--Budget;
 	}
+	DueFeedCaptures.Reset();
 }
 
 void AFICSubsystem::EndPlay(const EEndPlayReason::Type EndPlayReason) {
@@ -118,11 +281,13 @@ void AFICSubsystem::PostLoadGame_Implementation(int32 saveVersion, int32 gameVer
 			RuntimeProcesses.Remove(Process.Key);
 		}
 	}
+	InvalidateReferences();
 }
 
 bool AFICSubsystem::CreateRuntimeProcess(FString Key, UFICRuntimeProcess* InProcess, bool bStartAutomatically) {
 	RemoveRuntimeProcess(InProcess);
 	RuntimeProcesses.Add(Key, InProcess);
+	InvalidateReferences();
 	InProcess->Initialize();
 	if (bStartAutomatically) {
 		if (!StartRuntimeProcess(InProcess)) {
@@ -142,6 +307,7 @@ bool AFICSubsystem::RemoveRuntimeProcess(UFICRuntimeProcess* Process) {
 	Process->Shutdown();
 	
 	RuntimeProcesses.Remove(FindRuntimeProcessKey(Process));
+	InvalidateReferences();
 	
 	return true;
 }
@@ -197,23 +363,102 @@ void AFICSubsystem::DestoryRuntimeProcessorCharacter(AFICRuntimeProcessorCharact
 	OriginalPlayerCharacter = nullptr;
 }
 
-void AFICSubsystem::SaveRenderTargetAsJPG(const FString& FilePath, TSharedRef<FFICRenderTarget> RenderTarget) {
-	TSharedRef<FFICRenderRequest> RenderRequest = MakeShared<FFICRenderRequest>(RenderTarget, FilePath, FRHIGPUTextureReadback(TEXT("FICSubsystem Texture Readback")));
+void AFICSubsystem::SaveRenderTargetAsJPG(const FString& FilePath, TSharedRef<FFICRenderTarget> RenderTarget, const FFICImageOutputSettings& Settings) {
+	SaveRenderTargetAsJPG(TArray<FFICImageOutput>{FFICImageOutput(FilePath)}, RenderTarget, Settings);
+}
+
+void AFICSubsystem::SaveRenderTargetAsJPG(const TArray<FFICImageOutput>& Outputs, TSharedRef<FFICRenderTarget> RenderTarget, const FFICImageOutputSettings& Settings) {
+	if (Outputs.Num() < 1) return;
+	TSharedPtr<FRHIGPUTextureReadback> ProxyReadback;
+	if (Settings.bWriteProxy) ProxyReadback = ProxyReadbackPool.Acquire();
+	TSharedRef<FFICRenderRequest> RenderRequest = MakeShared<FFICRenderRequest>(RenderTarget, Outputs, Settings, ReadbackPool.Acquire(), ProxyReadback);
 		
-	ENQUEUE_RENDER_COMMAND(SceneDrawCompletion)([this, RenderTarget, RenderRequest](FRHICommandListImmediate& RHICmdList){
+	ENQUEUE_RENDER_COMMAND(SceneDrawCompletion)([RenderTarget, RenderRequest](FRHICommandListImmediate& RHICmdList){
 		FTexture2DRHIRef Target = RenderTarget->GetRenderTarget()->GetRenderTargetTexture();
-		RenderRequest->Readback.EnqueueCopy(RHICmdList, Target);
+		RenderRequest->SourceSize = Target->GetSizeXY();
+		RenderRequest->ReadbackSize = RenderRequest->SourceSize;
+		
+		const FFICImageOutputSettings& Settings = RenderRequest->Settings;
+		if (FFICImageProcessing::SupportsGPUConversion() && Settings.NeedsConversion(RenderRequest->SourceSize)) {
+			// Resample and swizzle on the GPU so only the final image has to be read back
+			RenderRequest->ReadbackSize = Settings.GetOutputSize(RenderRequest->SourceSize);
+			RenderRequest->bReadbackBGRA = Settings.Format == EFICImageFormat::BGRA;
+			EPixelFormat Format = RenderRequest->bReadbackBGRA ? PF_B8G8R8A8 : PF_R8G8B8A8;
+			RenderRequest->ConvertedTexture = FFICImageProcessing::ResampleOnGPU(RHICmdList, Target, RenderRequest->ReadbackSize, Format);
+			RenderRequest->Readback->EnqueueCopy(RHICmdList, RenderRequest->ConvertedTexture);
+
+			if (Settings.bWriteProxy) {
+				RenderRequest->ProxyReadbackSize = Settings.GetProxySize(RenderRequest->SourceSize);
+				RenderRequest->ProxyTexture = FFICImageProcessing::ResampleOnGPU(RHICmdList, RenderRequest->ConvertedTexture, RenderRequest->ProxyReadbackSize, Format);
+				RenderRequest->ProxyReadback->EnqueueCopy(RHICmdList, RenderRequest->ProxyTexture);
+			}
+		} else {
+			RenderRequest->Readback->EnqueueCopy(RHICmdList, Target);
+		}
 	});
 
 	RenderRequestQueue.Enqueue(RenderRequest);
+	INC_DWORD_STAT(STAT_FICPendingRenderRequests);
 	RenderRequest->RenderFence.BeginFence();
 }
 
+void AFICSubsystem::RequestTimelapseCapture(UFICRuntimeProcessTimelapseCamera* InProcess) {
+	PendingTimelapseCaptures.AddUnique(InProcess);
+}
+
+void AFICSubsystem::CancelTimelapseCapture(UFICRuntimeProcessTimelapseCamera* InProcess) {
+	PendingTimelapseCaptures.Remove(InProcess);
+}
+
+void AFICSubsystem::RequestFeedCapture(UFICRuntimeProcessCameraFeed* InProcess) {
+	DueFeedCaptures.Add(InProcess);
+}
+
 AFICScene* AFICSubsystem::FindSceneByName(const FString& InSceneName) {
+	AFICScene** Scene = SceneIndex.Find(InSceneName);
+	if (Scene && (!IsValid(*Scene) || (*Scene)->SceneName != InSceneName)) {
+		// the scene got renamed or destroyed without notifying us
+		RebuildSceneIndex();
+		Scene = SceneIndex.Find(InSceneName);
+	}
+	return Scene ? *Scene : nullptr;
+}
+
+void AFICSubsystem::RebuildSceneIndex() {
+	SceneIndex.Empty();
 	for (TActorIterator<AFICScene> Scene(GetWorld()); Scene; ++Scene) {
-		if (Scene->SceneName == InSceneName) return *Scene;
+		if (!Scene->IsPendingKill()) SceneIndex.FindOrAdd(Scene->SceneName, *Scene);
+	}
+	InvalidateReferences();
+}
+
+void AFICSubsystem::RegisterScene(AFICScene* InScene) {
+	SceneIndex.FindOrAdd(InScene->SceneName, InScene);
+	InvalidateReferences();
+}
+
+void AFICSubsystem::UnregisterScene(AFICScene* InScene) {
+	RemoveSceneFromIndex(InScene, InScene->SceneName);
+}
+
+void AFICSubsystem::OnSceneRenamed(AFICScene* InScene, const FString& InOldSceneName) {
+	RemoveSceneFromIndex(InScene, InOldSceneName);
+	RegisterScene(InScene);
+}
+
+void AFICSubsystem::RemoveSceneFromIndex(AFICScene* InScene, const FString& InSceneName) {
+	AFICScene** Scene = SceneIndex.Find(InSceneName);
+	if (!Scene || *Scene != InScene) return;
+	SceneIndex.Remove(InSceneName);
+	InvalidateReferences();
+	
+	// another scene with the same name might exist
+	for (TActorIterator<AFICScene> Other(GetWorld()); Other; ++Other) {
+		if (*Other != InScene && !Other->IsPendingKill() && Other->SceneName == InSceneName) {
+			SceneIndex.Add(InSceneName, *Other);
+			break;
+		}
 	}
-	return nullptr;
 }
 
 UFICRuntimeProcess* AFICSubsystem::FindRuntimeProcess(const FString& InKey) {
@@ -1,6 +1,7 @@
 ﻿#include "FICUtils.h"
 #include "FicsItCam/Public/FICUtils.h"
 
+#include "FICBezier.h"
 #include "Editor/FICEditorSubsystem.h"
 #include "GameFramework/InputSettings.h"
 #include "GameFramework/PlayerInput.h"
@@ -32,23 +33,7 @@ FString UFICUtils::KeymappingToString(const FString& Keymapping) {
 }
 
 float UFICUtils::BezierInterpolate(FVector2D P0, FVector2D P1, FVector2D P2, FVector2D P3, float t) {
-	float Lower = 0.0;
-	float Upper = 1.0;
-	float Current = 0.5;
-	float CurrentT;
-	float CurrentV;
-	int Increments = 0;
-	do {
-		CurrentT = FMath::Pow(1-Current, 3) * P0.X + 3*FMath::Pow(1-Current, 2) * Current * P1.X + 3*(1-Current) * Current*Current * P2.X + Current*Current*Current * P3.X;
-		CurrentV = FMath::Pow(1-Current, 3) * P0.Y + 3*FMath::Pow(1-Current, 2) * Current * P1.Y + 3*(1-Current) * Current*Current * P2.Y + Current*Current*Current * P3.Y;
-		if (CurrentT < t) {
-			Lower = Current;
-		} else if (CurrentT > t) {
-			Upper = Current;
-		}
-		Current = Lower + ((Upper - Lower)/2.0);
-	} while (FMath::Abs(t - CurrentT) > 0.001 && Increments++ < 100);
-	return CurrentV;
+	return FFICBezier::Interpolate(P0, P1, P2, P3, t);
 }
 
 FFICCameraSettingsSnapshot UFICUtils::CreateCameraSettingsSnapshotFromView(UObject* WorldContext) {
@@ -100,21 +85,5 @@ FString UFICUtils::AdjustSceneObjectName(AFICScene* Scene, FString Name) {
 	static FRegexPattern Pattern(TEXT("^(\\w+)(_[0-9]+)$"));
 	FRegexMatcher Match(Pattern, Name);
 	if (Match.FindNext()) Name = Match.GetCaptureGroup(1);
-	int Num = 1;
-	FString NewName = Name;
-	while (true) {
-		bool bFound = false;
-		for (UObject* Object : Scene->GetSceneObjects()) {
-			if (Cast<IFICSceneObject>(Object)->GetSceneObjectName() == NewName) {
-				bFound = true;
-				break;
-			}
-		}
-		if (bFound) {
-			NewName = FString::Printf(TEXT("%s_%i"), *Name, Num++);
-		} else {
-			break;
-		}
-	}
-	return NewName;
+	return Scene->MakeUniqueSceneObjectName(Name);
 }
@@ -4,15 +4,36 @@
 #include "Data/FICScene.h"
 #include "Runtime/Process/FICRuntimeProcessPlayScene.h"
 
-UFICRuntimeProcessPlayScene* FFICCameraReference::GetCurrentScenePlay(UObject* WorldContext) const {
-	if (!bUsePlay) return nullptr;
-	for (TPair<FString, UFICRuntimeProcess*> RuntimeProcess : AFICSubsystem::GetFICSubsystem(WorldContext)->GetRuntimeProcesses()) {
-		UFICRuntimeProcessPlayScene* PlayScene = Cast<UFICRuntimeProcessPlayScene>(RuntimeProcess.Value);
-		if (PlayScene && PlayScene->Scene->SceneName == Scene) {
-			return PlayScene;
+const FFICCameraReference::FResolved& FFICCameraReference::Resolve(UObject* WorldContext) const {
+	AFICSubsystem* SubSys = Resolved.Subsystem.Get();
+	if (!SubSys) SubSys = AFICSubsystem::GetFICSubsystem(WorldContext);
+	if (Resolved.Subsystem == SubSys && Resolved.Generation == SubSys->GetReferenceGeneration()) return Resolved;
+
+	Resolved = FResolved();
+	Resolved.Subsystem = SubSys;
+	Resolved.Generation = SubSys->GetReferenceGeneration();
+	if (Scene.Len() < 1) return Resolved;
+	
+	AFICScene* ScenePtr = SubSys->FindSceneByName(Scene);
+	Resolved.Scene = ScenePtr;
+	if (ScenePtr && Camera.Len() > 0) {
+		Resolved.Camera = Cast<UFICCamera>(ScenePtr->FindSceneObject(Camera));
+	}
+	if (bUsePlay) {
+		for (TPair<FString, UFICRuntimeProcess*> RuntimeProcess : SubSys->GetRuntimeProcesses()) {
+			UFICRuntimeProcessPlayScene* PlayScene = Cast<UFICRuntimeProcessPlayScene>(RuntimeProcess.Value);
+			if (PlayScene && PlayScene->Scene->SceneName == Scene) {
+				Resolved.PlayScene = PlayScene;
+				break;
+			}
 		}
 	}
-	return nullptr;
+	return Resolved;
+}
+
+UFICRuntimeProcessPlayScene* FFICCameraReference::GetCurrentScenePlay(UObject* WorldContext) const {
+	if (!bUsePlay) return nullptr;
+	return Resolve(WorldContext).PlayScene.Get();
 }
 
 FFICCameraReference FFICCameraReference::FromString(UObject* WorldContext, FString ReferenceString, FString* OutName) {
@@ -63,19 +84,19 @@ bool FFICCameraReference::IsValid(UObject* WorldContext) const {
 		return Scene.Len() > 0;
 	}
 	
-	AFICScene* ScenePtr = GetScene(WorldContext);
+	const FResolved& Resolution = Resolve(WorldContext);
+	AFICScene* ScenePtr = Resolution.Scene.Get();
 	if (!ScenePtr) return false;
+	if (Camera.Len() > 0) return Resolution.Camera.IsValid();
 
 	for (UObject* SceneObject : ScenePtr->GetSceneObjects()) {
-		UFICCamera* CameraPtr = Cast<UFICCamera>(SceneObject);
-		if (CameraPtr && (Camera.Len() < 1 || CameraPtr->GetSceneObjectName() == Camera)) return true;
+		if (Cast<UFICCamera>(SceneObject)) return true;
 	}
 	return false;
 }
 
 AFICScene* FFICCameraReference::GetScene(UObject* WorldContext) const {
-	if (Scene.Len() < 1) return nullptr;
-	return AFICSubsystem::GetFICSubsystem(WorldContext)->FindSceneByName(Scene);
+	return Resolve(WorldContext).Scene.Get();
 }
 
 FICFrameFloat FFICCameraReference::GetTime(UObject* WorldContext,UFICRuntimeProcessPlayScene** OptOutRuntimePlay) const {
@@ -93,16 +114,10 @@ UFICCamera* FFICCameraReference::GetCamera(UObject* WorldContext, UFICRuntimePro
 	if (OptOutRuntimePlay) *OptOutRuntimePlay = PlayScene;
 	if (OptOutTime) *OptOutTime = Time;
 	if (PlayScene) return PlayScene->Scene->GetActiveCamera(Time);
-	AFICScene* UsedScene = GetScene(WorldContext);
-	if (UsedScene) {
-		if (Camera.Len() < 1) return UsedScene->GetActiveCamera(Frame);
-		else for (UObject* SceneObject : UsedScene->GetSceneObjects()) {
-			UFICCamera* CameraPtr = Cast<UFICCamera>(SceneObject);
-			if (CameraPtr && CameraPtr->GetSceneObjectName() == Camera) {
-				return CameraPtr;
-			}
-		}
-	}
+	const FResolved& Resolution = Resolve(WorldContext);
+	if (Camera.Len() > 0) return Resolution.Camera.Get();
+	AFICScene* UsedScene = Resolution.Scene.Get();
+	if (UsedScene) return UsedScene->GetActiveCamera(Frame);
 	return nullptr;
 }
 
@@ -0,0 +1,223 @@
+#include "Runtime/FICImageProcessing.h"
+
+#include "CommonRenderResources.h"
+#include "EngineModule.h"
+#include "GlobalShader.h"
+#include "PipelineStateCache.h"
+#include "RendererInterface.h"
+#include "RHIStaticStates.h"
+#include "ScreenRendering.h"
+
+FIntPoint FFICImageOutputSettings::GetOutputSize(FIntPoint SourceSize) const {
+	if (Size.X <= 0 || Size.Y <= 0) return AlignSize(SourceSize);
+	return AlignSize(Size);
+}
+
+FIntPoint FFICImageOutputSettings::GetProxySize(FIntPoint SourceSize) const {
+	FIntPoint OutputSize = GetOutputSize(SourceSize);
+	return AlignSize(FIntPoint(OutputSize.X / 2, FMath::Max(OutputSize.Y / 2, 1)));
+}
+
+FIntPoint FFICImageOutputSettings::AlignSize(FIntPoint InSize) {
+	return FIntPoint(FMath::Max(FMath::DivideAndRoundNearest(InSize.X, WidthAlignment), 1) * WidthAlignment, InSize.Y);
+}
+
+bool FFICImageOutputSettings::NeedsConversion(FIntPoint SourceSize) const {
+	return GetOutputSize(SourceSize) != SourceSize || Format == EFICImageFormat::BGRA || bWriteProxy;
+}
+
+bool FFICImageProcessing::SupportsGPUConversion() {
+	return !GUsingNullRHI && FApp::CanEverRender();
+}
+
+FTexture2DRHIRef FFICImageProcessing::ResampleOnGPU(FRHICommandListImmediate& RHICmdList, FRHITexture2D* Source, FIntPoint Size, EPixelFormat Format) {
+	check(IsInRenderingThread());
+
+	FRHIResourceCreateInfo CreateInfo;
+	FTexture2DRHIRef Target = RHICreateTexture2D(Size.X, Size.Y, Format, 1, 1, TexCreate_RenderTargetable | TexCreate_ShaderResource, CreateInfo);
+
+	DrawTexture(RHICmdList, Source, Target, TStaticBlendState<>::GetRHI());
+
+	RHICmdList.Transition(FRHITransitionInfo(Target, ERHIAccess::RTV, ERHIAccess::CopySrc));
+
+	return Target;
+}
+
+void FFICImageProcessing::DrawTexture(FRHICommandListImmediate& RHICmdList, FRHITexture2D* Source, FRHITexture2D* Target, FRHIBlendState* BlendState, FLinearColor BlendFactor, ERenderTargetActions Actions) {
+	check(IsInRenderingThread());
+
+	FIntPoint Size = Target->GetSizeXY();
+	
+	RHICmdList.Transition(FRHITransitionInfo(Source, ERHIAccess::Unknown, ERHIAccess::SRVGraphics));
+	RHICmdList.Transition(FRHITransitionInfo(Target, ERHIAccess::Unknown, ERHIAccess::RTV));
+
+	FRHIRenderPassInfo RPInfo(Target, Actions);
+	RHICmdList.BeginRenderPass(RPInfo, TEXT("FICImageDraw"));
+	{
+		RHICmdList.SetViewport(0, 0, 0.0f, Size.X, Size.Y, 1.0f);
+
+		FGraphicsPipelineStateInitializer GraphicsPSOInit;
+		RHICmdList.ApplyCachedRenderTargets(GraphicsPSOInit);
+		GraphicsPSOInit.BlendState = BlendState;
+		GraphicsPSOInit.RasterizerState = TStaticRasterizerState<>::GetRHI();
+		GraphicsPSOInit.DepthStencilState = TStaticDepthStencilState<false, CF_Always>::GetRHI();
+
+		FGlobalShaderMap* ShaderMap = GetGlobalShaderMap(GMaxRHIFeatureLevel);
+		TShaderMapRef<FScreenVS> VertexShader(ShaderMap);
+		TShaderMapRef<FScreenPS> PixelShader(ShaderMap);
+		GraphicsPSOInit.BoundShaderState.VertexDeclarationRHI = GFilterVertexDeclaration.VertexDeclarationRHI;
+		GraphicsPSOInit.BoundShaderState.VertexShaderRHI = VertexShader.GetVertexShader();
+		GraphicsPSOInit.BoundShaderState.PixelShaderRHI = PixelShader.GetPixelShader();
+		GraphicsPSOInit.PrimitiveType = PT_TriangleList;
+		SetGraphicsPipelineState(RHICmdList, GraphicsPSOInit);
+		RHICmdList.SetBlendFactor(BlendFactor);
+
+		PixelShader->SetParameters(RHICmdList, TStaticSamplerState<SF_Bilinear>::GetRHI(), Source);
+
+		FIntPoint SourceSize = Source->GetSizeXY();
+		GetRendererModule().DrawRectangle(RHICmdList, 0, 0, Size.X, Size.Y, 0, 0, SourceSize.X, SourceSize.Y, Size, SourceSize, VertexShader, EDRF_UseTriangleOptimization);
+	}
+	RHICmdList.EndRenderPass();
+}
+
+void FFICImageProcessing::Resample(const TArray64<uint8>& InPixels, FIntPoint InSize, TArray64<uint8>& OutPixels, FIntPoint OutSize) {
+	if (InSize == OutSize) {
+		OutPixels = InPixels;
+		return;
+	}
+
+	OutPixels.SetNumUninitialized((int64)OutSize.X * OutSize.Y * 4);
+	for (int32 Y = 0; Y < OutSize.Y; ++Y) {
+		int32 SrcY0 = (int64)Y * InSize.Y / OutSize.Y;
+		int32 SrcY1 = FMath::Max(SrcY0 + 1, (int32)((int64)(Y + 1) * InSize.Y / OutSize.Y));
+		for (int32 X = 0; X < OutSize.X; ++X) {
+			int32 SrcX0 = (int64)X * InSize.X / OutSize.X;
+			int32 SrcX1 = FMath::Max(SrcX0 + 1, (int32)((int64)(X + 1) * InSize.X / OutSize.X));
+
+			// box filter over all source pixels covered by the output pixel
+			uint32 Sum[4] = {0, 0, 0, 0};
+			for (int32 SrcY = SrcY0; SrcY < SrcY1; ++SrcY) {
+				const uint8* Pixel = &InPixels[((int64)SrcY * InSize.X + SrcX0) * 4];
+				for (int32 SrcX = SrcX0; SrcX < SrcX1; ++SrcX, Pixel += 4) {
+					Sum[0] += Pixel[0];
+					Sum[1] += Pixel[1];
+					Sum[2] += Pixel[2];
+					Sum[3] += Pixel[3];
+				}
+			}
+			uint32 Count = (SrcY1 - SrcY0) * (SrcX1 - SrcX0);
+			uint8* OutPixel = &OutPixels[((int64)Y * OutSize.X + X) * 4];
+			for (int32 Channel = 0; Channel < 4; ++Channel) OutPixel[Channel] = Sum[Channel] / Count;
+		}
+	}
+}
+
+void FFICImageProcessing::SwizzleRedBlue(TArray64<uint8>& InOutPixels) {
+	for (int64 i = 0; i + 3 < InOutPixels.Num(); i += 4) {
+		Swap(InOutPixels[i], InOutPixels[i+2]);
+	}
+}
+
+void FFICImageProcessing::ConvertToYUV420(const TArray64<uint8>& InPixels, FIntPoint InSize, bool bBGRA, TArray64<uint8>& OutPlanes) {
+	const int32 ChromaWidth = (InSize.X + 1) / 2;
+	const int32 ChromaHeight = (InSize.Y + 1) / 2;
+	const int64 LumaSize = (int64)InSize.X * InSize.Y;
+	const int64 ChromaSize = (int64)ChromaWidth * ChromaHeight;
+	OutPlanes.SetNumUninitialized(LumaSize + ChromaSize * 2);
+	uint8* PlaneY = OutPlanes.GetData();
+	uint8* PlaneU = PlaneY + LumaSize;
+	uint8* PlaneV = PlaneU + ChromaSize;
+
+	const int32 R = bBGRA ? 2 : 0;
+	const int32 B = bBGRA ? 0 : 2;
+
+	// Full range BT.601 (same as JPEG) in I420 plane layout
+	for (int64 i = 0; i < LumaSize; ++i) {
+		const uint8* Pixel = &InPixels[i * 4];
+		PlaneY[i] = FMath::Clamp(FMath::RoundToInt(0.299f * Pixel[R] + 0.587f * Pixel[1] + 0.114f * Pixel[B]), 0, 255);
+	}
+	for (int32 Y = 0; Y < ChromaHeight; ++Y) {
+		for (int32 X = 0; X < ChromaWidth; ++X) {
+			float SumR = 0, SumG = 0, SumB = 0;
+			int32 Count = 0;
+			for (int32 SrcY = Y*2; SrcY < FMath::Min(Y*2 + 2, InSize.Y); ++SrcY) {
+				for (int32 SrcX = X*2; SrcX < FMath::Min(X*2 + 2, InSize.X); ++SrcX) {
+					const uint8* Pixel = &InPixels[((int64)SrcY * InSize.X + SrcX) * 4];
+					SumR += Pixel[R];
+					SumG += Pixel[1];
+					SumB += Pixel[B];
+					++Count;
+				}
+			}
+			SumR /= Count;
+			SumG /= Count;
+			SumB /= Count;
+			int64 Index = (int64)Y * ChromaWidth + X;
+			PlaneU[Index] = FMath::Clamp(FMath::RoundToInt(128.0f - 0.168736f * SumR - 0.331264f * SumG + 0.5f * SumB), 0, 255);
+			PlaneV[Index] = FMath::Clamp(FMath::RoundToInt(128.0f + 0.5f * SumR - 0.418688f * SumG - 0.081312f * SumB), 0, 255);
+		}
+	}
+}
+
+void FFICImageChangeDetector::QueueDecision(const TArray<TSharedPtr<FFICImageChangeDetector>>& Detectors, TUniqueFunction<void()> Decision) {
+	check(IsInGameThread());
+	FGraphEventArray Prerequisites;
+	for (const TSharedPtr<FFICImageChangeDetector>& Detector : Detectors) {
+		if (Detector->LastDecision) Prerequisites.Add(Detector->LastDecision);
+	}
+	FGraphEventRef Event = FFunctionGraphTask::CreateAndDispatchWhenReady(MoveTemp(Decision), TStatId(), &Prerequisites, ENamedThreads::AnyBackgroundThreadNormalTask);
+	for (const TSharedPtr<FFICImageChangeDetector>& Detector : Detectors) {
+		Detector->LastDecision = Event;
+	}
+}
+
+bool FFICImageChangeDetector::ShouldStore(const TArray64<uint8>& Pixels, FIntPoint Size, bool bBGRA, const FString& Path) {
+	TArray<uint8> Signature;
+	ComputeSignature(Pixels, Size, bBGRA, Signature);
+
+	bool bStore = true;
+	if (PreviousSignature.Num() == Signature.Num()) {
+		int64 Difference = 0;
+		for (int32 i = 0; i < Signature.Num(); ++i) {
+			Difference += FMath::Abs((int32)Signature[i] - (int32)PreviousSignature[i]);
+		}
+		bStore = (float)Difference / (float)(Signature.Num() * 255) >= Threshold;
+	}
+
+	FString File = FPaths::GetCleanFilename(Path);
+	FString Line = bStore ? File : FString::Printf(TEXT("%s repeat %s"), *File, *PreviousFile);
+	if (!Manifest) Manifest.Reset(IFileManager::Get().CreateFileWriter(*ManifestPath, FILEWRITE_Append | FILEWRITE_AllowRead));
+	if (Manifest) {
+		FTCHARToUTF8 UTF8(*(Line + LINE_TERMINATOR));
+		Manifest->Serialize((void*)UTF8.Get(), UTF8.Length());
+		// flushed per line, so the manifest is complete up to the last decision while the capture keeps running
+		Manifest->Flush();
+	}
+	
+	if (bStore) {
+		PreviousSignature = MoveTemp(Signature);
+		PreviousFile = File;
+	}
+	return bStore;
+}
+
+void FFICImageChangeDetector::ComputeSignature(const TArray64<uint8>& Pixels, FIntPoint Size, bool bBGRA, TArray<uint8>& OutSignature) {
+	// averages a fixed grid of samples per cell instead of every pixel, keeps the cost independent of the image size
+	const int32 R = bBGRA ? 2 : 0;
+	const int32 B = bBGRA ? 0 : 2;
+	OutSignature.SetNumUninitialized(SignatureSize * SignatureSize);
+	for (int32 CellY = 0; CellY < SignatureSize; ++CellY) {
+		for (int32 CellX = 0; CellX < SignatureSize; ++CellX) {
+			float Sum = 0.0f;
+			for (int32 SampleY = 0; SampleY < SamplesPerCell; ++SampleY) {
+				int32 Y = FMath::Min((int32)(((int64)CellY * SamplesPerCell + SampleY) * Size.Y / (SignatureSize * SamplesPerCell)), Size.Y - 1);
+				for (int32 SampleX = 0; SampleX < SamplesPerCell; ++SampleX) {
+					int32 X = FMath::Min((int32)(((int64)CellX * SamplesPerCell + SampleX) * Size.X / (SignatureSize * SamplesPerCell)), Size.X - 1);
+					const uint8* Pixel = &Pixels[((int64)Y * Size.X + X) * 4];
+					Sum += 0.299f * Pixel[R] + 0.587f * Pixel[1] + 0.114f * Pixel[B];
+				}
+			}
+			OutSignature[CellY * SignatureSize + CellX] = FMath::Clamp(FMath::RoundToInt(Sum / (SamplesPerCell * SamplesPerCell)), 0, 255);
+		}
+	}
+}
@@ -20,12 +20,22 @@ void UFICRuntimeProcessCameraFeed::LoadWindowSettings() {
 	Window->Resize(WindowSize);
 }
 
+bool UFICRuntimeProcessCameraFeed::IsWindowVisible() const {
+	// Slate doesn't tell if a window is covered by other windows, so only hidden and minimized windows are skipped
+	return Window.IsValid() && Window->IsVisible() && !Window->IsWindowMinimized();
+}
+
 void UFICRuntimeProcessCameraFeed::Start(AFICRuntimeProcessorCharacter* InCharacter) {
 	Camera = GetWorld()->SpawnActor<AFICCaptureCamera>();
 	CameraArgument.InitalizeCaptureCamera(Camera);
 
-	Brush = FSlateImageBrush(Camera->RenderTarget, FVector2D(Camera->RenderTarget->SizeX, Camera->RenderTarget->SizeY));
 	FVector2D Resolution = CameraArgument.GetResolution(this);
+	float Scale = FMath::Clamp(ResolutionScale, 0.01f, 1.0f);
+	if (Scale < 1.0f) {
+		Camera->RenderTarget->ResizeTarget(FMath::Max(1, FMath::RoundToInt(Resolution.X * Scale)), FMath::Max(1, FMath::RoundToInt(Resolution.Y * Scale)));
+	}
+
+	Brush = FSlateImageBrush(Camera->RenderTarget, Resolution);
 	Window = SNew(SWindow)[
 		SNew(SImage)
 		.Image(&Brush)
@@ -43,14 +53,32 @@ void UFICRuntimeProcessCameraFeed::Start(AFICRuntimeProcessorCharacter* InCharac
 
 	LoadWindowSettings();
 
-	Camera->CaptureComponent->bCaptureEveryFrame = true;
+	Camera->CaptureComponent->bCaptureEveryFrame = false;
+	TimeSinceCapture = 0.0f;
 
 	Camera->CopyCameraData(Cast<UCameraComponent>(Cast<AFGCharacterPlayer>(GetWorld()->GetFirstPlayerController()->GetCharacter())->GetComponentByClass(UCameraComponent::StaticClass())));
 }
 
 void UFICRuntimeProcessCameraFeed::Tick(AFICRuntimeProcessorCharacter* InCharacter, float DeltaSeconds) {
-	Camera->CopyCameraData(Camera->Camera);
+	TimeSinceCapture += DeltaSeconds;
+	LastDeltaSeconds = DeltaSeconds;
+	if (TargetCaptureRate > 0.0f && TimeSinceCapture < 1.0f / TargetCaptureRate) return;
+	if (!IsWindowVisible()) return;
+	AFICSubsystem::GetFICSubsystem(this)->RequestFeedCapture(this);
+}
+
+float UFICRuntimeProcessCameraFeed::GetCaptureLateness() const {
+	if (TargetCaptureRate > 0.0f) return TimeSinceCapture * TargetCaptureRate;
+	// feeds without rate limit are due every tick
+	return LastDeltaSeconds > 0.0f ? TimeSinceCapture / LastDeltaSeconds : 1.0f;
+}
+
+void UFICRuntimeProcessCameraFeed::Capture() {
+	TimeSinceCapture = 0.0f;
+	
 	CameraArgument.UpdateCameraSettings(Camera);
+	Camera->CopyCameraData(Camera->Camera);
+	Camera->CaptureComponent->CaptureSceneDeferred();
 	/*if (CameraArgument.CameraReference.IsAnimated()) {
 	} else {
 //		FSlateApplication::Get().GetGameViewport()->GetViewportInterface().Pin()->GetViewportRenderTargetTexture()-> 
@@ -1,9 +1,12 @@
 #include "Runtime/Process/FICRuntimeProcessPlayScene.h"
 
 #include "CineCameraComponent.h"
+#include "FICStats.h"
 #include "FICSubsystem.h"
 #include "Command/CommandSender.h"
 
+DECLARE_CYCLE_STAT(TEXT("Play Scene Tick"), STAT_FICPlaySceneTick, STATGROUP_FicsItCam);
+
 void UFICRuntimeProcessPlayScene::Initialize() {
 	Super::Initialize();
 	Progress = (float)Scene->AnimationRange.Begin / (float)Scene->FPS;
@@ -26,14 +29,13 @@ void UFICRuntimeProcessPlayScene::Start(AFICRuntimeProcessorCharacter* InCharact
 		Cast<IFICSceneObject>(SceneObject)->InitAnimation();
 	}
 
+	// no active check bound, the active objects get resolved from the keyframes of the active attributes
 	ActiveSceneObjectManager.Initialize(Scene);
-	ActiveSceneObjectManager.IsSceneObjectActive.BindLambda([this](UObject* SceneObject, FICFrameFloat Frame) {
-		IFICSceneObjectActive* Active = Cast<IFICSceneObjectActive>(SceneObject);
-		return Active->GetActiveAttribute().GetValue(Frame);
-	});
 }
 
 void UFICRuntimeProcessPlayScene::Tick(AFICRuntimeProcessorCharacter* InCharacter, float DeltaTime) {
+	SCOPE_CYCLE_COUNTER(STAT_FICPlaySceneTick);
+	
 	FICFrameFloat Time = Progress * Scene->FPS;
 	
 	ActiveSceneObjectManager.UpdateActiveObjects(Time);
@@ -1,10 +1,12 @@
 #include "Runtime/Process/FICRuntimeProcessRenderScene.h"
 
+#include "CineCameraComponent.h"
 #include "EngineModule.h"
 #include "FICSubsystem.h"
 #include "IImageWrapperModule.h"
 #include "Components/SceneCaptureComponent2D.h"
 #include "Engine/TextureRenderTarget2D.h"
+#include "RHIStaticStates.h"
 #include "GTE/Mathematics/Logger.h"
 #include "Runtime/FICCaptureCamera.h"
 #include "Slate/SceneViewport.h"
@@ -21,19 +23,60 @@ void UFICRuntimeProcessRenderScene::Start(AFICRuntimeProcessorCharacter* InChara
 		Settings->MinUndilatedFrameTime = 0;
 		Settings->MaxUndilatedFrameTime = 0;
 	} else {
-		Settings->MinUndilatedFrameTime = 1.0/(double)Scene->FPS;
+		// every sample is its own game tick, so scene objects and the world move between the samples of a frame
+		Settings->MinUndilatedFrameTime = 1.0/(double)(Scene->FPS * MotionBlurSamples);
 		Settings->MaxUndilatedFrameTime = Settings->MinUndilatedFrameTime;
 	}
 	FrameProgress = Scene->AnimationRange.Begin;
+	SubFrameProgress = 0;
 	
 	FViewportClient* ViewportClient = GetWorld()->GetGameViewport();
 	DummyViewport = MakeShared<FFICRendererViewport>(ViewportClient, Scene->ResolutionWidth, Scene->ResolutionHeight);
+	if (MotionBlurSamples > 1) {
+		AccumulationTarget = MakeShared<FFICAccumulationTarget>(FIntPoint(Scene->ResolutionWidth, Scene->ResolutionHeight));
+	}
+
+	// Create Output Directories
+	// TODO: Get UFGSaveSystem::GetSaveDirectoryPath() working
+	OutputDirectory = FPaths::Combine(FPlatformProcess::UserSettingsDir(), FApp::GetProjectName(), TEXT("Saved/") TEXT("SaveGames/") TEXT("FicsItCam/"), Scene->SceneName);
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	if (!PlatformFile.DirectoryExists(*OutputDirectory)) PlatformFile.CreateDirectoryTree(*OutputDirectory);
+
+	// Setup Multi Camera Outputs
+	OutputCaptureCameras.Empty();
+	if (Scene->bMultiCameraRender) {
+		for (UObject* SceneObject : Scene->GetSceneObjects()) {
+			UFICCamera* Camera = Cast<UFICCamera>(SceneObject);
+			if (!Camera || !Camera->bRenderOutput) continue;
+			
+			AFICCaptureCamera* OutputCamera = GetWorld()->SpawnActor<AFICCaptureCamera>();
+			OutputCamera->SetCamera(true, Scene->bUseCinematic);
+			OutputCamera->RenderTarget->ResizeTarget(Scene->ResolutionWidth, Scene->ResolutionHeight);
+			UCineCameraComponent* CineCamera = Cast<UCineCameraComponent>(OutputCamera->Camera);
+			if (CineCamera) {
+				CineCamera->FocusSettings.FocusMethod = ECameraFocusMethod::Manual;
+				CineCamera->Filmback.SensorWidth = Scene->SensorDimension.X;
+				CineCamera->Filmback.SensorHeight = Scene->SensorDimension.Y;
+			} else {
+				OutputCamera->Camera->SetAspectRatio((float)Scene->ResolutionWidth / (float)Scene->ResolutionHeight);
+			}
+			OutputCaptureCameras.Add(Camera, OutputCamera);
+			if (MotionBlurSamples > 1) {
+				OutputAccumulationTargets.Add(Camera, MakeShared<FFICAccumulationTarget>(FIntPoint(Scene->ResolutionWidth, Scene->ResolutionHeight)));
+			}
+
+			FString CameraDirectory = FPaths::Combine(OutputDirectory, Camera->GetSceneObjectName());
+			if (!PlatformFile.DirectoryExists(*CameraDirectory)) PlatformFile.CreateDirectoryTree(*CameraDirectory);
+		}
+	}
 }
 
 void UFICRuntimeProcessRenderScene::Tick(AFICRuntimeProcessorCharacter* InCharacter, float DeltaSeconds) {
 	if(GetWorld()->IsLevelStreamingRequestPending(GetWorld()->GetFirstPlayerController())) return;
 
-	Progress = (float)FrameProgress / (float)Scene->FPS;
+	// the samples of a frame lead up to the frame, so the last sample matches the frame without motion blur
+	FICFrameFloat SubFrameOffset = (float)(MotionBlurSamples - 1 - SubFrameProgress) / (float)MotionBlurSamples;
+	Progress = ((float)FrameProgress - SubFrameOffset) / (float)Scene->FPS;
 	Super::Tick(InCharacter, DeltaSeconds);
 
 	// Capture Image
@@ -50,26 +93,104 @@ void UFICRuntimeProcessRenderScene::Tick(AFICRuntimeProcessorCharacter* InCharac
 		//GetRendererModule().SceneRenderTargetsSetBufferSize(RestoreSize.X, RestoreSize.Y);
 	//});
 
-	// Create Save Path
-	FString FSP;
-	// TODO: Get UFGSaveSystem::GetSaveDirectoryPath() working
-	if (FSP.IsEmpty()) {
-		FSP = FPaths::Combine(FPlatformProcess::UserSettingsDir(), FApp::GetProjectName(), TEXT("Saved/") TEXT("SaveGames/") TEXT("FicsItCam/"), Scene->SceneName);
+	// Capture additional cameras from the same world state
+	bool bFirstSample = SubFrameProgress == 0;
+	bool bLastSample = SubFrameProgress == MotionBlurSamples - 1;
+	CaptureOutputCameras(FrameProgress - SubFrameOffset, bFirstSample, bLastSample);
+
+	TSharedRef<FFICRenderTarget> Output = DummyViewport.ToSharedRef();
+	if (AccumulationTarget) {
+		AccumulateSample(AccumulationTarget.Get(), DummyViewport.Get(), bFirstSample, bLastSample);
+		if (!bLastSample) {
+			++SubFrameProgress;
+			return;
+		}
+		SubFrameProgress = 0;
+		Output = AccumulationTarget.ToSharedRef();
 	}
-	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
-	if (!PlatformFile.DirectoryExists(*FSP)) PlatformFile.CreateDirectoryTree(*FSP);
-	FSP = FPaths::Combine(FSP, FString::FromInt(FrameProgress) + TEXT(".jpeg"));
 
 	// Store Image
-	AFICSubsystem::GetFICSubsystem(this)->SaveRenderTargetAsJPG(FSP, DummyViewport.ToSharedRef());
+	FString FSP = FPaths::Combine(OutputDirectory, FString::FromInt(FrameProgress) + TEXT(".jpeg"));
+	AFICSubsystem::GetFICSubsystem(this)->SaveRenderTargetAsJPG(FSP, Output, OutputSettings);
 	
 	++FrameProgress;
 }
 
 void UFICRuntimeProcessRenderScene::Stop(AFICRuntimeProcessorCharacter* InCharacter) {
 	Super::Stop(InCharacter);
+
+	for (const TPair<UFICCamera*, AFICCaptureCamera*>& Output : OutputCaptureCameras) {
+		if (Output.Value) Output.Value->Destroy();
+	}
+	OutputCaptureCameras.Empty();
+	OutputAccumulationTargets.Empty();
+	AccumulationTarget.Reset();
 	
 	auto* Settings = GetWorld()->GetWorldSettings();
 	Settings->MinUndilatedFrameTime = PrevMinUndilatedFrameTime;
 	Settings->MaxUndilatedFrameTime = PrevMaxUndilatedFrameTime;
 }
+
+void UFICRuntimeProcessRenderScene::AccumulateSample(FFICAccumulationTarget* Target, FRenderTarget* Sample, bool bFirstSample, bool bLastSample) {
+	float Weight = 1.0f / (float)MotionBlurSamples;
+	// the accumulation targets flush the rendering commands on destruction and the samples are kept for the whole render, so both outlive the command
+	ENQUEUE_RENDER_COMMAND(FICAccumulateSample)([Target, Sample, Weight, bFirstSample, bLastSample](FRHICommandListImmediate& RHICmdList) {
+		Target->AccumulateSample_RenderThread(RHICmdList, Sample->GetRenderTargetTexture(), Weight, bFirstSample);
+		if (bLastSample) Target->Resolve_RenderThread(RHICmdList);
+	});
+}
+
+void UFICRuntimeProcessRenderScene::CaptureOutputCameras(FICFrameFloat Time, bool bFirstSample, bool bLastSample) {
+	AFICSubsystem* SubSys = AFICSubsystem::GetFICSubsystem(this);
+	for (const TPair<UFICCamera*, AFICCaptureCamera*>& Output : OutputCaptureCameras) {
+		UFICCamera* Camera = Output.Key;
+		AFICCaptureCamera* OutputCamera = Output.Value;
+		
+		OutputCamera->SetActorLocationAndRotation(Camera->Position.Get(Time), Camera->Rotation.Get(Time));
+		OutputCamera->Camera->SetFieldOfView(Camera->FOV.GetValue(Time));
+		UCineCameraComponent* CineCamera = Cast<UCineCameraComponent>(OutputCamera->Camera);
+		if (CineCamera) {
+			CineCamera->CurrentAperture = Camera->Aperture.GetValue(Time);
+			CineCamera->FocusSettings.ManualFocusDistance = Camera->FocusDistance.GetValue(Time);
+		}
+		OutputCamera->CopyCameraData(OutputCamera->Camera);
+		OutputCamera->CaptureComponent->CaptureScene();
+
+		TSharedRef<FFICRenderTarget> Target = MakeShared<FFICRenderTarget_Raw>(OutputCamera->RenderTarget->GameThread_GetRenderTargetResource());
+		TSharedPtr<FFICAccumulationTarget>* AccumulationTargetPtr = OutputAccumulationTargets.Find(Camera);
+		if (AccumulationTargetPtr) {
+			AccumulateSample(AccumulationTargetPtr->Get(), Target->GetRenderTarget(), bFirstSample, bLastSample);
+			if (!bLastSample) continue;
+			Target = AccumulationTargetPtr->ToSharedRef();
+		}
+
+		FString FSP = FPaths::Combine(OutputDirectory, Camera->GetSceneObjectName(), FString::FromInt(FrameProgress) + TEXT(".jpeg"));
+		SubSys->SaveRenderTargetAsJPG(FSP, Target, OutputSettings);
+	}
+}
+
+void FFICAccumulationTarget::InitDynamicRHI() {
+	FRHIResourceCreateInfo CreateInfo;
+	// half float is enough to average 8-bit samples and can be blended on every RHI
+	AccumulationTexture = RHICreateTexture2D(Size.X, Size.Y, PF_FloatRGBA, 1, 1, TexCreate_RenderTargetable | TexCreate_ShaderResource, CreateInfo);
+	RenderTargetTextureRHI = RHICreateTexture2D(Size.X, Size.Y, PF_R8G8B8A8, 1, 1, TexCreate_RenderTargetable | TexCreate_ShaderResource, CreateInfo);
+}
+
+void FFICAccumulationTarget::ReleaseDynamicRHI() {
+	AccumulationTexture.SafeRelease();
+	RenderTargetTextureRHI.SafeRelease();
+}
+
+void FFICAccumulationTarget::AccumulateSample_RenderThread(FRHICommandListImmediate& RHICmdList, FRHITexture2D* Sample, float Weight, bool bFirstSample) {
+	FLinearColor BlendFactor(Weight, Weight, Weight, Weight);
+	if (bFirstSample) {
+		FFICImageProcessing::DrawTexture(RHICmdList, Sample, AccumulationTexture, TStaticBlendState<CW_RGBA, BO_Add, BF_BlendFactor, BF_Zero, BO_Add, BF_BlendFactor, BF_Zero>::GetRHI(), BlendFactor, ERenderTargetActions::DontLoad_Store);
+	} else {
+		FFICImageProcessing::DrawTexture(RHICmdList, Sample, AccumulationTexture, TStaticBlendState<CW_RGBA, BO_Add, BF_BlendFactor, BF_One, BO_Add, BF_BlendFactor, BF_One>::GetRHI(), BlendFactor, ERenderTargetActions::Load_Store);
+	}
+}
+
+void FFICAccumulationTarget::Resolve_RenderThread(FRHICommandListImmediate& RHICmdList) {
+	FFICImageProcessing::DrawTexture(RHICmdList, AccumulationTexture, RenderTargetTextureRHI, TStaticBlendState<>::GetRHI());
+	RHICmdList.Transition(FRHITransitionInfo(RenderTargetTextureRHI, ERHIAccess::RTV, ERHIAccess::CopySrc));
+}
@@ -1,6 +1,5 @@
 #include "Runtime/Process/FICRuntimeProcessTimelapseCamera.h"
 
-#include "FGPlayerController.h"
 #include "FICSubsystem.h"
 #include "Runtime/FICCaptureCamera.h"
 
@@ -10,38 +9,58 @@ void UFICRuntimeProcessTimelapseCamera::Start(AFICRuntimeProcessorCharacter* InC
 	Time = 0.0f;
 	CaptureStart = FDateTime::Now();
 	CaptureIncrement = 0;
+	bCaptureRequested = false;
+
+	// TODO: Get UFGSaveSystem::GetSaveDirectoryPath() working
+	OutputDirectory = FPaths::Combine(FPlatformProcess::UserSettingsDir(), FApp::GetProjectName(), TEXT("Saved/") TEXT("SaveGames/"), TEXT("FicsItCam/"), CameraArgument.GetSimpleName());
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	if (!PlatformFile.DirectoryExists(*OutputDirectory)) PlatformFile.CreateDirectoryTree(*OutputDirectory);
+
+	ChangeDetector.Reset();
+	if (bSkipUnchangedFrames) {
+		ChangeDetector = MakeShared<FFICImageChangeDetector>(ChangeThreshold, FPaths::Combine(OutputDirectory, FString::Printf(TEXT("%s-manifest.txt"), *CaptureStart.ToString())));
+	}
 }
 
 void UFICRuntimeProcessTimelapseCamera::Tick(AFICRuntimeProcessorCharacter* InCharacter, float DeltaSeconds) {
 	Time += DeltaSeconds;
-	if (Time < SecondsPerFrame) return;
+	if (Time < SecondsPerFrame || bCaptureRequested) return;
 	Time -= SecondsPerFrame;
-	
-	AFGPlayerController* Controller = Cast<AFGPlayerController>(GetWorld()->GetFirstPlayerController());
-	//if (Character) Character->SetThirdPersonMode();
 
+	bCaptureRequested = true;
+	AFICSubsystem::GetFICSubsystem(this)->RequestTimelapseCapture(this);
+}
+
+void UFICRuntimeProcessTimelapseCamera::Stop(AFICRuntimeProcessorCharacter* InCharacter) {
+	AFICSubsystem::GetFICSubsystem(this)->CancelTimelapseCapture(this);
+	bCaptureRequested = false;
+	if (CaptureCamera) CaptureCamera->Destroy();
+}
+
+void UFICRuntimeProcessTimelapseCamera::Capture(const TArray<UFICRuntimeProcessTimelapseCamera*>& SharedWith) {
 	CameraArgument.UpdateCameraSettings(CaptureCamera);
 	CaptureCamera->CopyCameraData(CaptureCamera->Camera);
-	
-	CaptureCamera->CaptureComponent->CaptureSceneDeferred();
+	CaptureCamera->CaptureComponent->CaptureScene();
 
-	FString FSP;
-	// TODO: Get UFGSaveSystem::GetSaveDirectoryPath() working
-	if (FSP.IsEmpty()) {
-		FSP = FPaths::Combine(FPlatformProcess::UserSettingsDir(), FApp::GetProjectName(), TEXT("Saved/") TEXT("SaveGames/"));
+	AFICSubsystem* SubSys = AFICSubsystem::GetFICSubsystem(this);
+	TSharedRef<FFICRenderTarget> RenderTarget = MakeShared<FFICRenderTarget_Raw>(CaptureCamera->RenderTarget->GameThread_GetRenderTargetResource());
+	TArray<FFICImageOutput> Outputs;
+	Outputs.Add(ConsumeCaptureOutput());
+	for (UFICRuntimeProcessTimelapseCamera* Other : SharedWith) {
+		Outputs.Add(Other->ConsumeCaptureOutput());
 	}
-	FSP = FPaths::Combine(FSP, TEXT("FicsItCam/"), CameraArgument.GetSimpleName());
-	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
-	if (!PlatformFile.DirectoryExists(*FSP)) PlatformFile.CreateDirectoryTree(*FSP);
-	FSP = FPaths::Combine(FSP, FString::Printf(TEXT("%s-%i.jpg"), *CaptureStart.ToString(), CaptureIncrement));
-
-	AFICSubsystem::GetFICSubsystem(this)->SaveRenderTargetAsJPG(FSP, MakeShared<FFICRenderTarget_Raw>(CaptureCamera->RenderTarget->GameThread_GetRenderTargetResource()));
-
-	++CaptureIncrement;
+	SubSys->SaveRenderTargetAsJPG(Outputs, RenderTarget);
+}
 
-	//if (Character) Character->SetFirstPersonMode();
+bool UFICRuntimeProcessTimelapseCamera::CanShareCapture(UFICRuntimeProcessTimelapseCamera* Other) {
+	bool bCinematic = CameraArgument.GetUseCinematic(this);
+	if (bCinematic != Other->CameraArgument.GetUseCinematic(Other)) return false;
+	if (bCinematic && CameraArgument.GetSensorDimensions(this) != Other->CameraArgument.GetSensorDimensions(Other)) return false;
+	if (CameraArgument.GetResolution(this) != Other->CameraArgument.GetResolution(Other)) return false;
+	return CameraArgument.GetCameraSettingsSnapshot(this).Equals(Other->CameraArgument.GetCameraSettingsSnapshot(Other));
 }
 
-void UFICRuntimeProcessTimelapseCamera::Stop(AFICRuntimeProcessorCharacter* InCharacter) {
-	if (CaptureCamera) CaptureCamera->Destroy();
+FFICImageOutput UFICRuntimeProcessTimelapseCamera::ConsumeCaptureOutput() {
+	bCaptureRequested = false;
+	return FFICImageOutput(FPaths::Combine(OutputDirectory, FString::Printf(TEXT("%s-%i.jpg"), *CaptureStart.ToString(), CaptureIncrement++)), ChangeDetector);
 }
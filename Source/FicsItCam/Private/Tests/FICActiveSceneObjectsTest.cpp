@@ -0,0 +1,164 @@
+#include "Tests/FICTestUtils.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Data/FICActiveSceneObjectManager.h"
+#include "Data/FICActiveTimeline.h"
+#include "Data/Objects/FICCamera.h"
+#include "Runtime/Process/FICRuntimeProcessPlayScene.h"
+
+static TArray<UObject*> ToObjects(const TArray<UFICCamera*>& Cameras) {
+	return TArray<UObject*>(Cameras);
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFICActiveTimelineTest, "FicsItCam.ActiveSceneObjects.Timeline", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+bool FFICActiveTimelineTest::RunTest(const FString& Parameters) {
+	FFICTestSceneSize Size = FFICTestSceneSize::FromCommandLine();
+	TArray<UObject*> Cameras = ToObjects(FFICTestScene::CreateCameras(GetTransientPackage(), Size, 1));
+	FFICActiveTimeline Timeline;
+	Timeline.Build(Cameras);
+
+	for (FICFrame Frame = -10; Frame <= Size.GetLastFrame() + 10; ++Frame) {
+		if (Timeline.Resolve(Frame) != FFICTestScene::FindActiveCamera(Cameras, Frame)) {
+			AddError(FString::Printf(TEXT("Timeline resolves a different camera than the active attributes at frame %lld"), Frame));
+			return false;
+		}
+	}
+
+	// every cut has to change the active object and has to match the timeline
+	UObject* Previous = nullptr;
+	int32 Cuts = 0;
+	for (FFICActiveTimeline::FCutIterator Cut = Timeline.CreateCutIterator(); Cut; ++Cut, ++Cuts) {
+		if (Cuts > 0) {
+			TestNotEqual(TEXT("Cut changes the active object"), Cut.GetObject(), Previous);
+			TestEqual(TEXT("Cut object"), Cut.GetObject(), Timeline.Resolve(Cut.GetFrame()));
+		}
+		Previous = Cut.GetObject();
+	}
+	TestEqual(TEXT("Cuts"), Cuts, Timeline.Breakpoints.Num() + 1);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFICActiveSceneObjectManagerTest, "FicsItCam.ActiveSceneObjects.Manager", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+bool FFICActiveSceneObjectManagerTest::RunTest(const FString& Parameters) {
+	FFICTestSceneSize Size = FFICTestSceneSize::FromCommandLine();
+	FFICTestWorld World;
+	AFICScene* Scene = World.SpawnScene(Size, 2);
+	TArray<UObject*> Cameras = Scene->GetSceneObjects();
+
+	FFICActiveSceneObjectManager Manager;
+	Manager.Initialize(Scene);
+	Manager.UpdateActiveObjects(0);
+	TestEqual(TEXT("Update delegates"), Manager.GetNumUpdateDelegates(), Cameras.Num());
+	for (FICFrame Frame = 0; Frame <= Size.GetLastFrame(); ++Frame) {
+		Manager.UpdateActiveObjects(Frame);
+		if (Manager.GetActiveSceneObject(TEXT("Camera")) != FFICTestScene::FindActiveCamera(Cameras, Frame)) {
+			AddError(FString::Printf(TEXT("Manager activated a different camera than the active attributes at frame %lld"), Frame));
+			return false;
+		}
+	}
+
+	// keyframe changes have to rebuild the timelines
+	UFICCamera* First = Cast<UFICCamera>(Cameras[0]);
+	First->Active.SetKeyframe(Size.GetLastFrame() + 100, FFICKeyframeBool(true));
+	Manager.UpdateActiveObjects(Size.GetLastFrame() + 100);
+	TestEqual(TEXT("Active camera after keyframe change"), Manager.GetActiveSceneObject(TEXT("Camera")), (UObject*)First);
+
+	// a bound check replaces the timelines
+	UObject* Last = Cameras.Last();
+	Manager.IsSceneObjectActive.BindLambda([Last](UObject* SceneObject, FICFrameFloat) {
+		return SceneObject == Last;
+	});
+	Manager.UpdateActiveObjects(0);
+	TestEqual(TEXT("Active camera of bound check"), Manager.GetActiveSceneObject(TEXT("Camera")), Last);
+
+	// after shutdown no delegates may stay registered, not even by following updates
+	Manager.Shutdown();
+	Manager.UpdateActiveObjects(0);
+	TestNull(TEXT("Active camera after shutdown"), Manager.GetActiveSceneObject(TEXT("Camera")));
+	TestEqual(TEXT("Update delegates after shutdown"), Manager.GetNumUpdateDelegates(), 0);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFICPlaySceneTest, "FicsItCam.ActiveSceneObjects.PlayScene", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+bool FFICPlaySceneTest::RunTest(const FString& Parameters) {
+	FFICTestSceneSize Size = FFICTestSceneSize::FromCommandLine();
+	FFICTestWorld World;
+	AFICScene* Scene = World.SpawnScene(Size, 3);
+	TArray<UObject*> Cameras = Scene->GetSceneObjects();
+
+	// played in the background, so no runtime processor character is needed
+	UFICRuntimeProcessPlayScene* Process = NewObject<UFICRuntimeProcessPlayScene>(Scene);
+	Process->Scene = Scene;
+	Process->bBackground = true;
+	Process->Initialize();
+	Process->Start(nullptr);
+	for (FICFrame Frame = Scene->AnimationRange.Begin; Frame < Scene->AnimationRange.End; ++Frame) {
+		FICFrameFloat Time = Process->GetProgress() * Scene->FPS;
+		Process->Tick(nullptr, 1.0f / Scene->FPS);
+		if (Scene->GetActiveCamera(Time) != FFICTestScene::FindActiveCamera(Cameras, Time)) {
+			AddError(FString::Printf(TEXT("Play scene used a different camera than the active attributes at frame %f"), Time));
+			break;
+		}
+	}
+	Process->Stop(nullptr);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFICActiveSceneObjectsPerfTest, "FicsItCam.Perf.ActiveSceneObjects", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+bool FFICActiveSceneObjectsPerfTest::RunTest(const FString& Parameters) {
+	FFICTestSceneSize Size = FFICTestSceneSize::FromCommandLine();
+	FFICPerfBaselines& Baselines = FFICPerfBaselines::Get();
+
+	// resolving has to stay logarithmic, four times the cameras and keyframes may not cost four times as much
+	double ResolveNs[2];
+	for (int32 i = 0; i < 2; ++i) {
+		FFICTestSceneSize ScaledSize = Size * (i ? 4 : 1);
+		FFICActiveTimeline Timeline;
+		Timeline.Build(ToObjects(FFICTestScene::CreateCameras(GetTransientPackage(), ScaledSize, 4)));
+		FICFrame LastFrame = ScaledSize.GetLastFrame();
+		ResolveNs[i] = FFICPerfBaselines::Measure(20, 10000, [&]() {
+			for (int32 Sample = 0; Sample < 10000; ++Sample) Timeline.Resolve((Sample * 7919) % LastFrame);
+		});
+	}
+	Baselines.Check(*this, TEXT("ActiveTimeline.Resolve"), Size, ResolveNs[0], 2000.0);
+	if (ResolveNs[1] > ResolveNs[0] * 3.0) {
+		AddError(FString::Printf(TEXT("Resolving the active timeline scales worse than logarithmic (%.1f ns/op at %s, %.1f ns/op at %s)"), ResolveNs[0], *Size.ToString(), ResolveNs[1], *(Size * 4).ToString()));
+	}
+
+	FFICTestWorld World;
+	AFICScene* Scene = World.SpawnScene(Size, 5);
+	TArray<UObject*> Cameras = Scene->GetSceneObjects();
+	FICFrame LastFrame = Size.GetLastFrame();
+
+	double BuildNs = FFICPerfBaselines::Measure(10, 1, [&]() {
+		FFICActiveTimeline Timeline;
+		Timeline.Build(Cameras);
+	});
+	Baselines.Check(*this, TEXT("ActiveTimeline.Build"), Size, BuildNs, 50000.0 * Size.Cameras * Size.KeyframesPerCamera);
+
+	FFICActiveSceneObjectManager Manager;
+	Manager.Initialize(Scene);
+	Manager.UpdateActiveObjects(0);
+	double UpdateNs = FFICPerfBaselines::Measure(20, LastFrame, [&]() {
+		for (FICFrame Frame = 0; Frame < LastFrame; ++Frame) Manager.UpdateActiveObjects(Frame);
+	});
+	Manager.Shutdown();
+	Baselines.Check(*this, TEXT("ActiveSceneObjectManager.Update"), Size, UpdateNs, 10000.0);
+
+	UFICRuntimeProcessPlayScene* Process = NewObject<UFICRuntimeProcessPlayScene>(Scene);
+	Process->Scene = Scene;
+	Process->bBackground = true;
+	Scene->bLooping = true;
+	Process->Initialize();
+	Process->Start(nullptr);
+	double TickNs = FFICPerfBaselines::Measure(20, LastFrame, [&]() {
+		for (FICFrame Frame = 0; Frame < LastFrame; ++Frame) Process->Tick(nullptr, 1.0f / Scene->FPS);
+	});
+	Process->Stop(nullptr);
+	// every tick evaluates the active camera and ticks all scene objects
+	Baselines.Check(*this, TEXT("PlayScene.Tick"), Size, TickNs, 20000.0 + 1000.0 * Size.Cameras);
+	return true;
+}
+
+#endif
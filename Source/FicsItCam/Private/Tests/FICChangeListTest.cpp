@@ -0,0 +1,127 @@
+#include "Tests/FICTestUtils.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Data/Objects/FICCamera.h"
+#include "Editor/FICChangeList.h"
+
+static TSharedRef<FFICChange> SetValueChange(FFICFloatAttribute& Attribute, FICFrame Frame, float Value, FFICChangeSource Source = FFICChangeSource()) {
+	TSharedRef<FFICAttribute> From = Attribute.Get();
+	Attribute.SetKeyframe(Frame, FFICFloatKeyframe(Value));
+	return MakeShared<FFICChange_Attribute>(&Attribute, From, Source);
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFICChangeListUndoRedoTest, "FicsItCam.ChangeList.UndoRedo", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+bool FFICChangeListUndoRedoTest::RunTest(const FString& Parameters) {
+	FFICFloatAttribute Attribute;
+	FFICChangeList ChangeList;
+
+	for (int32 i = 1; i <= 3; ++i) ChangeList.PushChange(SetValueChange(Attribute, 0, i));
+	TestEqual(TEXT("Changes"), ChangeList.Num(), 3);
+	TestEqual(TEXT("Value after changes"), Attribute.GetValue(0), 3.0f);
+
+	ChangeList.PopChange()->UndoChange();
+	ChangeList.PopChange()->UndoChange();
+	TestEqual(TEXT("Value after two undos"), Attribute.GetValue(0), 1.0f);
+
+	ChangeList.PushChange()->RedoChange();
+	TestEqual(TEXT("Value after redo"), Attribute.GetValue(0), 2.0f);
+
+	// a new change drops the changes that could still be redone
+	ChangeList.PushChange(SetValueChange(Attribute, 0, 10));
+	TestEqual(TEXT("Changes after new change"), ChangeList.Num(), 3);
+	TestFalse(TEXT("Nothing to redo"), ChangeList.PushChange().IsValid());
+
+	while (TSharedPtr<FFICChange> Change = ChangeList.PopChange()) Change->UndoChange();
+	TestEqual(TEXT("Keyframes after undoing everything"), Attribute.GetKeyframes().Num(), 0);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFICChangeListStackingTest, "FicsItCam.ChangeList.Stacking", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+bool FFICChangeListStackingTest::RunTest(const FString& Parameters) {
+	FFICFloatAttribute Attribute;
+	FFICChangeList ChangeList;
+	FFICChangeSource Source(&Attribute, TEXT("Drag"));
+
+	for (int32 i = 1; i <= 10; ++i) ChangeList.PushChange(SetValueChange(Attribute, 0, i, Source));
+	TestEqual(TEXT("Changes of the same source get stacked"), ChangeList.Num(), 1);
+
+	ChangeList.PopChange()->UndoChange();
+	TestEqual(TEXT("Keyframes after undo"), Attribute.GetKeyframes().Num(), 0);
+	ChangeList.PushChange()->RedoChange();
+	TestEqual(TEXT("Value after redo"), Attribute.GetValue(0), 10.0f);
+
+	// deltas stacked onto a full snapshot capture the resulting state on undo, the history has to account for it
+	TArray<FICFrame> Frames;
+	for (FICFrame Frame = 1; Frame <= 100; ++Frame) Frames.Add(Frame);
+	TSharedRef<FFICChange_AttributeDelta> Delta = MakeShared<FFICChange_AttributeDelta>(&Attribute, Frames, Source);
+	for (FICFrame Frame : Frames) Attribute.SetKeyframe(Frame, FFICFloatKeyframe(Frame));
+	Delta->CaptureAfter();
+	ChangeList.PushChange(Delta);
+	TestEqual(TEXT("Delta gets stacked"), ChangeList.Num(), 1);
+	SIZE_T StackedUsage = ChangeList.GetMemoryUsage();
+	ChangeList.PopChange()->UndoChange();
+	TestTrue(TEXT("Memory usage grows by the captured state"), ChangeList.GetMemoryUsage() > StackedUsage);
+	ChangeList.PushChange()->RedoChange();
+	TestEqual(TEXT("Keyframes after redoing the stacked delta"), Attribute.GetKeyframes().Num(), 101);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFICChangeListMemoryBudgetTest, "FicsItCam.ChangeList.MemoryBudget", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+bool FFICChangeListMemoryBudgetTest::RunTest(const FString& Parameters) {
+	FFICFloatAttribute Attribute;
+	for (int32 Frame = 0; Frame < 100; ++Frame) Attribute.SetKeyframe(Frame, FFICFloatKeyframe(Frame));
+
+	FFICChangeList ChangeList;
+	ChangeList.PushChange(SetValueChange(Attribute, 0, -1));
+	SIZE_T ChangeSize = ChangeList.GetMemoryUsage();
+	ChangeList.SetMemoryBudget(ChangeSize * 5);
+
+	for (int32 i = 0; i < 20; ++i) ChangeList.PushChange(SetValueChange(Attribute, 0, i));
+	TestTrue(TEXT("Memory usage within budget"), ChangeList.GetMemoryUsage() <= ChangeList.GetMemoryBudget());
+	TestTrue(TEXT("Oldest changes got dropped"), ChangeList.Num() <= 5);
+	TestTrue(TEXT("Newest changes are kept"), ChangeList.Num() >= 4);
+
+	int32 Undos = 0;
+	while (TSharedPtr<FFICChange> Change = ChangeList.PopChange()) {
+		Change->UndoChange();
+		++Undos;
+	}
+	TestEqual(TEXT("Every kept change can be undone"), Undos, ChangeList.Num());
+	TestEqual(TEXT("Value before the oldest kept change"), Attribute.GetValue(0), (float)(19 - Undos));
+
+	// the newest change stays even if it alone exceeds the budget
+	ChangeList.SetMemoryBudget(1);
+	TestEqual(TEXT("Changes with tiny budget"), ChangeList.Num(), 1);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFICChangeListPerfTest, "FicsItCam.Perf.ChangeList", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+bool FFICChangeListPerfTest::RunTest(const FString& Parameters) {
+	FFICTestSceneSize Size = FFICTestSceneSize::FromCommandLine();
+	UFICCamera* Camera = FFICTestScene::CreateCameras(GetTransientPackage(), FFICTestSceneSize(2, Size.KeyframesPerCamera * Size.Cameras), 1)[0];
+	const TArray<FICFrame> Frames = Camera->FOV.GetFrames();
+	FFICChangeList ChangeList;
+
+	// keyframe edits capture a delta of the edited keyframes over the whole camera, like moving a keyframe in the graph view
+	int32 Edit = 0;
+	double PushNs = FFICPerfBaselines::Measure(10, 100, [&]() {
+		for (int32 i = 0; i < 100; ++i) {
+			FICFrame Frame = Frames[(Edit++ * 7919) % Frames.Num()];
+			TSharedRef<FFICChange_AttributeDelta> Change = MakeShared<FFICChange_AttributeDelta>(&Camera->GetRootAttribute(), TArray<FICFrame>{Frame});
+			Camera->FOV.GetKeyframe(Frame)->Value += 1.0f;
+			Change->CaptureAfter();
+			ChangeList.PushChange(Change);
+		}
+	});
+	FFICPerfBaselines::Get().Check(*this, TEXT("ChangeList.PushDelta"), Size, PushNs, 200000.0);
+
+	double UndoRedoNs = FFICPerfBaselines::Measure(10, 100, [&]() {
+		for (int32 i = 0; i < 50; ++i) ChangeList.PopChange()->UndoChange();
+		for (int32 i = 0; i < 50; ++i) ChangeList.PushChange()->RedoChange();
+	});
+	FFICPerfBaselines::Get().Check(*this, TEXT("ChangeList.UndoRedo"), Size, UndoRedoNs, 200000.0);
+	return true;
+}
+
+#endif
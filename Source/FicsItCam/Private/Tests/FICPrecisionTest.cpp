@@ -0,0 +1,63 @@
+#include "Tests/FICTestUtils.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Data/Attributes/FICAttributeFloat.h"
+
+/** Half the extent of the largest map in unreal units, positions of scenes stay within it */
+static constexpr double MapExtent = 425000.0;
+
+/**
+ * Double precision reference of a bezier segment, with the control points in absolute times and values.
+ */
+static double EvaluateReference(const FFICFloatKeyframe& Key1, double Time1, const FFICFloatKeyframe& Key2, double Time2, double Time) {
+	const double P0[2] = {Time1, Key1.Value};
+	const double P1[2] = {Time1 + Key1.OutTanTime, (double)Key1.Value + Key1.OutTanValue};
+	const double P2[2] = {Time2 - Key2.InTanTime, (double)Key2.Value - Key2.InTanValue};
+	const double P3[2] = {Time2, Key2.Value};
+	auto Point = [&](double u, int32 Axis) {
+		double v = 1.0 - u;
+		return v*v*v * P0[Axis] + 3.0 * v*v*u * P1[Axis] + 3.0 * v*u*u * P2[Axis] + u*u*u * P3[Axis];
+	};
+	double Lower = 0.0, Upper = 1.0;
+	for (int32 i = 0; i < 100; ++i) {
+		double u = (Lower + Upper) / 2.0;
+		if (Point(u, 0) < Time) Lower = u;
+		else Upper = u;
+	}
+	return Point((Lower + Upper) / 2.0, 1);
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFICPrecisionTest, "FicsItCam.Precision", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+bool FFICPrecisionTest::RunTest(const FString& Parameters) {
+	// slow dolly moves of one and a half meters over 20 seconds, at the origin, within and at the border of the map
+	for (double Origin : {-MapExtent, -MapExtent / 2.0, 0.0, MapExtent / 2.0, MapExtent}) {
+		FFICFloatAttribute Attribute;
+		const FICFrame Frames[] = {0, 600, 1200};
+		const double Offsets[] = {0.0, 100.0, 150.0};
+		for (int32 i = 0; i < UE_ARRAY_COUNT(Frames); ++i) Attribute.SetKeyframe(Frames[i], FFICFloatKeyframe((float)(Origin + Offsets[i])));
+		Attribute.RecalculateDirtyKeyframes();
+
+		double MaxError = 0.0;
+		double MaxErrorBound = 0.0;
+		for (FICFrameFloat Time = 0.0f; Time <= 1200.0f; Time += 0.25f) {
+			int32 Segment = Time < 600.0f ? 0 : 1;
+			double Reference = EvaluateReference(*Attribute.GetKeyframe(Frames[Segment]), Frames[Segment], *Attribute.GetKeyframe(Frames[Segment+1]), Frames[Segment+1], Time);
+			double Error = FMath::Abs((double)Attribute.GetValue(Time) - Reference);
+			// rounding the result to float is unavoidable, everything on top of that may only be the bisection tolerance of the segment time
+			double ErrorBound = FMath::Abs(Reference) * FLT_EPSILON + 0.001;
+			if (Error > ErrorBound) {
+				AddError(FString::Printf(TEXT("Value at frame %.2f with origin %.0f is off by %f (bound %f)"), Time, Origin, Error, ErrorBound));
+				return false;
+			}
+			if (Error > MaxError) {
+				MaxError = Error;
+				MaxErrorBound = ErrorBound;
+			}
+		}
+		AddInfo(FString::Printf(TEXT("Origin %.0f: max error %f (bound %f)"), Origin, MaxError, MaxErrorBound));
+	}
+	return true;
+}
+
+#endif
@@ -0,0 +1,219 @@
+#include "Tests/FICTestUtils.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "FICSubsystem.h"
+#include "Engine/TextureRenderTarget2D.h"
+#include "HAL/FileManager.h"
+
+/**
+ * Subsystem and render target of a render queue test, kept alive until the latent command finished.
+ */
+struct FFICRenderQueueTestContext {
+	FFICTestWorld World;
+	AFICSubsystem* Subsystem = nullptr;
+	UTextureRenderTarget2D* Texture = nullptr;
+	TSharedPtr<FFICRenderTarget> RenderTarget;
+	FString Directory;
+
+	/** Files that have to exist with the given size once all requests are done, a negative size only checks existence */
+	TMap<FString, int64> ExpectedFiles;
+	/** Files that may not exist once all requests are done */
+	TArray<FString> UnexpectedFiles;
+	TArray<FString> ExpectedManifest;
+	FString ManifestPath;
+
+	double TickSeconds = 0.0;
+	int32 Ticks = 0;
+
+	FFICRenderQueueTestContext(const FString& Name, FIntPoint Size) {
+		Subsystem = World.GetWorld()->SpawnActor<AFICSubsystem>();
+		Texture = NewObject<UTextureRenderTarget2D>();
+		Texture->AddToRoot();
+		Texture->InitCustomFormat(Size.X, Size.Y, PF_B8G8R8A8, false);
+		Texture->UpdateResourceImmediate(true);
+		RenderTarget = MakeShared<FFICRenderTarget_Raw>(Texture->GameThread_GetRenderTargetResource());
+
+		Directory = FPaths::Combine(FPaths::AutomationTransientDir(), TEXT("FicsItCam"), Name);
+		IFileManager::Get().DeleteDirectory(*Directory, false, true);
+		IFileManager::Get().MakeDirectory(*Directory, true);
+	}
+
+	~FFICRenderQueueTestContext() {
+		FlushRenderingCommands();
+		Texture->RemoveFromRoot();
+		IFileManager::Get().DeleteDirectory(*Directory, false, true);
+	}
+
+	FString GetPath(const FString& File) const { return FPaths::Combine(Directory, File); }
+};
+
+/**
+ * Ticks the subsystem until all render requests got read back and their files got written, then verifies the files.
+ */
+class FFICWaitForRenderQueue : public IAutomationLatentCommand {
+public:
+	FFICWaitForRenderQueue(FAutomationTestBase* Test, TSharedRef<FFICRenderQueueTestContext> Context, TFunction<void()> OnDone = nullptr) : Test(Test), Context(Context), OnDone(OnDone) {}
+
+	virtual bool Update() override {
+		static constexpr double Timeout = 30.0;
+
+		if (Context->Subsystem->HasPendingRenderRequests()) {
+			uint64 Start = FPlatformTime::Cycles64();
+			Context->Subsystem->Tick(0.0f);
+			Context->TickSeconds += FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - Start);
+			++Context->Ticks;
+		}
+
+		// the files are written by async tasks after the request left the queue
+		bool bDone = !Context->Subsystem->HasPendingRenderRequests();
+		for (const TPair<FString, int64>& File : Context->ExpectedFiles) {
+			bDone = bDone && IFileManager::Get().FileSize(*File.Key) >= 0;
+		}
+		if (!Context->ManifestPath.IsEmpty()) {
+			TArray<FString> Manifest;
+			FFileHelper::LoadFileToStringArray(Manifest, *Context->ManifestPath);
+			bDone = bDone && Manifest.Num() >= Context->ExpectedManifest.Num();
+		}
+
+		if (!bDone) {
+			if (GetCurrentRunTime() < Timeout) return false;
+			Test->AddError(FString::Printf(TEXT("Render requests didn't finish within %.0f seconds"), Timeout));
+			return true;
+		}
+
+		// give pending writes of the last request a moment, so the size checks see complete files
+		if (DoneTime < 0.0) DoneTime = GetCurrentRunTime();
+		if (GetCurrentRunTime() < DoneTime + 0.2) return false;
+
+		Verify();
+		if (OnDone) OnDone();
+		return true;
+	}
+
+private:
+	FAutomationTestBase* Test;
+	TSharedRef<FFICRenderQueueTestContext> Context;
+	TFunction<void()> OnDone;
+	double DoneTime = -1.0;
+
+	void Verify() {
+		for (const TPair<FString, int64>& File : Context->ExpectedFiles) {
+			int64 Size = IFileManager::Get().FileSize(*File.Key);
+			if (File.Value >= 0 && Size != File.Value) {
+				Test->AddError(FString::Printf(TEXT("'%s' has %lld bytes instead of %lld"), *FPaths::GetCleanFilename(File.Key), Size, File.Value));
+			}
+		}
+		for (const FString& File : Context->UnexpectedFiles) {
+			if (IFileManager::Get().FileExists(*File)) Test->AddError(FString::Printf(TEXT("'%s' should not have been written"), *FPaths::GetCleanFilename(File)));
+		}
+		if (!Context->ManifestPath.IsEmpty()) {
+			TArray<FString> Manifest;
+			FFileHelper::LoadFileToStringArray(Manifest, *Context->ManifestPath);
+			Test->TestEqual(TEXT("Manifest lines"), Manifest, Context->ExpectedManifest);
+		}
+	}
+};
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFICReadbackPoolTest, "FicsItCam.RenderQueue.ReadbackPool", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+bool FFICReadbackPoolTest::RunTest(const FString& Parameters) {
+	FFICReadbackPool Pool(TEXT("FICTestReadback"));
+	TSharedRef<FRHIGPUTextureReadback> Readback = Pool.Acquire();
+	Pool.Release(Readback);
+	TestTrue(TEXT("Released readback gets reused"), Pool.Acquire() == Readback);
+	TestFalse(TEXT("Acquired readback is not handed out twice"), Pool.Acquire() == Readback);
+
+	TArray<TSharedRef<FRHIGPUTextureReadback>> Readbacks;
+	for (int32 i = 0; i < 20; ++i) Readbacks.Add(Pool.Acquire());
+	for (const TSharedRef<FRHIGPUTextureReadback>& Released : Readbacks) Pool.Release(Released);
+	TSet<FRHIGPUTextureReadback*> Reused;
+	for (int32 i = 0; i < 20; ++i) {
+		TSharedRef<FRHIGPUTextureReadback> Acquired = Pool.Acquire();
+		if (Readbacks.Contains(Acquired)) Reused.Add(&Acquired.Get());
+	}
+	TestTrue(TEXT("Pool keeps a limited amount of free readbacks"), Reused.Num() > 0 && Reused.Num() < 20);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFICRenderQueueTest, "FicsItCam.RenderQueue.Outputs", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+bool FFICRenderQueueTest::RunTest(const FString& Parameters) {
+	const FIntPoint Size(64, 48);
+	TSharedRef<FFICRenderQueueTestContext> Context = MakeShared<FFICRenderQueueTestContext>(TEXT("RenderQueue"), Size);
+	TSharedRef<FFICRenderTarget> RenderTarget = Context->RenderTarget.ToSharedRef();
+
+	// one request fanned out to multiple paths, with proxies
+	FFICImageOutputSettings JPGSettings;
+	JPGSettings.bWriteProxy = true;
+	for (int32 i = 0; i < 4; ++i) {
+		FString PathA = Context->GetPath(FString::Printf(TEXT("A/%i.jpg"), i));
+		FString PathB = Context->GetPath(FString::Printf(TEXT("B/%i.jpg"), i));
+		Context->Subsystem->SaveRenderTargetAsJPG({FFICImageOutput(PathA), FFICImageOutput(PathB)}, RenderTarget, JPGSettings);
+		for (const FString& Path : {PathA, PathB}) {
+			Context->ExpectedFiles.Add(Path, -1);
+			Context->ExpectedFiles.Add(FPaths::GetBaseFilename(Path, false) + TEXT("_proxy.jpg"), -1);
+		}
+	}
+
+	// raw outputs have a exactly known size, the downscale is done by the CPU reference implementation under the null RHI
+	// and the width gets rounded to whole readback rows
+	FFICImageOutputSettings BGRASettings;
+	BGRASettings.Format = EFICImageFormat::BGRA;
+	BGRASettings.Size = FIntPoint(40, 24);
+	Context->Subsystem->SaveRenderTargetAsJPG(Context->GetPath(TEXT("Raw/0.jpg")), RenderTarget, BGRASettings);
+	Context->ExpectedFiles.Add(Context->GetPath(TEXT("Raw/0.bgra")), 64 * 24 * 4);
+
+	FFICImageOutputSettings YUVSettings;
+	YUVSettings.Format = EFICImageFormat::YUV420;
+	Context->Subsystem->SaveRenderTargetAsJPG(Context->GetPath(TEXT("Raw/1.jpg")), RenderTarget, YUVSettings);
+	Context->ExpectedFiles.Add(Context->GetPath(TEXT("Raw/1.yuv")), Size.X * Size.Y + 2 * (Size.X / 2) * (Size.Y / 2));
+
+	// identical images, only the first one gets stored and the manifest has to list all frames in request order
+	Context->ManifestPath = Context->GetPath(TEXT("Timelapse/manifest.txt"));
+	TSharedPtr<FFICImageChangeDetector> ChangeDetector = MakeShared<FFICImageChangeDetector>(0.01f, Context->ManifestPath);
+	for (int32 i = 0; i < 6; ++i) {
+		FString Path = Context->GetPath(FString::Printf(TEXT("Timelapse/%i.jpg"), i));
+		Context->Subsystem->SaveRenderTargetAsJPG({FFICImageOutput(Path, ChangeDetector)}, RenderTarget);
+		if (i == 0) {
+			Context->ExpectedFiles.Add(Path, -1);
+			Context->ExpectedManifest.Add(TEXT("0.jpg"));
+		} else {
+			Context->UnexpectedFiles.Add(Path);
+			Context->ExpectedManifest.Add(FString::Printf(TEXT("%i.jpg repeat 0.jpg"), i));
+		}
+	}
+
+	TestTrue(TEXT("Requests are queued"), Context->Subsystem->HasPendingRenderRequests());
+	ADD_LATENT_AUTOMATION_COMMAND(FFICWaitForRenderQueue(this, Context));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFICRenderQueuePerfTest, "FicsItCam.Perf.RenderQueue", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+bool FFICRenderQueuePerfTest::RunTest(const FString& Parameters) {
+	// scene size scales the amount of requests, like a scene with that many output cameras
+	FFICTestSceneSize SceneSize = FFICTestSceneSize::FromCommandLine();
+	const int32 Requests = FMath::Max(SceneSize.Cameras, 4);
+	TSharedRef<FFICRenderQueueTestContext> Context = MakeShared<FFICRenderQueueTestContext>(TEXT("RenderQueuePerf"), FIntPoint(64, 48));
+	TSharedRef<FFICRenderTarget> RenderTarget = Context->RenderTarget.ToSharedRef();
+
+	FFICImageOutputSettings Settings;
+	Settings.Format = EFICImageFormat::BGRA;
+	int32 Request = 0;
+	double EnqueueNs = FFICPerfBaselines::Measure(4, Requests / 4, [&]() {
+		for (int32 i = 0; i < Requests / 4; ++i, ++Request) {
+			FString Path = Context->GetPath(FString::Printf(TEXT("%i.jpg"), Request));
+			Context->Subsystem->SaveRenderTargetAsJPG(Path, RenderTarget, Settings);
+			Context->ExpectedFiles.Add(FPaths::ChangeExtension(Path, TEXT("bgra")), 64 * 48 * 4);
+		}
+	});
+	FFICPerfBaselines::Get().Check(*this, TEXT("RenderQueue.Enqueue"), SceneSize, EnqueueNs, 200000.0);
+
+	ADD_LATENT_AUTOMATION_COMMAND(FFICWaitForRenderQueue(this, Context, [this, Context, SceneSize]() {
+		// every tick pops at most one request, the readback and the start of the async write are on the game thread
+		TestTrue(TEXT("Every request took a tick"), Context->Ticks >= Context->ExpectedFiles.Num());
+		double TickNs = Context->TickSeconds * 1e9 / FMath::Max(Context->Ticks, 1);
+		FFICPerfBaselines::Get().Check(*this, TEXT("RenderQueue.Tick"), SceneSize, TickNs, 2000000.0);
+	}));
+	return true;
+}
+
+#endif
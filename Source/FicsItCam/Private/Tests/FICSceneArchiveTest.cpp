@@ -0,0 +1,97 @@
+#include "Tests/FICTestUtils.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Data/FICSceneArchive.h"
+#include "Data/Objects/FICCamera.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFICSceneArchiveRoundTripTest, "FicsItCam.SceneArchive.RoundTrip", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+bool FFICSceneArchiveRoundTripTest::RunTest(const FString& Parameters) {
+	FFICTestWorld World;
+	const FFICTestSceneSize Size(4, 16);
+	AFICScene* Source = World.SpawnScene(Size, 6);
+	AFICScene* Target = World.SpawnScene(Size, 7);
+
+	// scene object names are not unique, every object still has to get its own keyframes
+	TArray<UObject*> SourceObjects = Source->GetSceneObjects();
+	TArray<UObject*> TargetObjects = Target->GetSceneObjects();
+	for (int32 i = 0; i < SourceObjects.Num(); ++i) {
+		Cast<UFICCamera>(SourceObjects[i])->SceneObjectName = TEXT("Camera");
+		Cast<UFICCamera>(TargetObjects[i])->SceneObjectName = TEXT("Camera");
+	}
+
+	TArray<uint8> Data;
+	FFICSceneArchive::Save(Source, Data);
+	TestTrue(TEXT("Scene data is readable"), FFICSceneArchive::Load(Target, Data));
+	TArray<uint8> Loaded;
+	FFICSceneArchive::Save(Target, Loaded);
+	TestTrue(TEXT("Loaded scene writes the same scene data"), Loaded == Data);
+
+	// the unchanged scene objects after a removed one still get their keyframes
+	Source->RemoveSceneObject(SourceObjects[0]);
+	Cast<UFICCamera>(SourceObjects[1])->SceneObjectName = TEXT("Renamed");
+	FFICSceneArchive::Save(Source, Data);
+	AFICScene* Reordered = World.SpawnScene(Size, 8);
+	TArray<UObject*> ReorderedObjects = Reordered->GetSceneObjects();
+	Reordered->RemoveSceneObject(ReorderedObjects[0]);
+	Cast<UFICCamera>(ReorderedObjects[1])->SceneObjectName = TEXT("Camera");
+	Cast<UFICCamera>(ReorderedObjects[2])->SceneObjectName = TEXT("Renamed");
+	Cast<UFICCamera>(ReorderedObjects[3])->SceneObjectName = TEXT("Camera");
+	TestTrue(TEXT("Scene data of changed scene is readable"), FFICSceneArchive::Load(Reordered, Data));
+	TestEqual(TEXT("Renamed object found by name"), Cast<UFICCamera>(ReorderedObjects[2])->FOV.GetFrames(), Cast<UFICCamera>(SourceObjects[1])->FOV.GetFrames());
+	TestEqual(TEXT("Object with duplicate name found by index"), Cast<UFICCamera>(ReorderedObjects[3])->FOV.GetFrames(), Cast<UFICCamera>(SourceObjects[3])->FOV.GetFrames());
+	return true;
+}
+
+/**
+ * Spawns a scene with the given amount of keyframes spread evenly over the float channels of ten cameras.
+ */
+static AFICScene* SpawnArchiveScene(FFICTestWorld& World, int32 Keys) {
+	const int32 NumCameras = 10;
+	AFICScene* Scene = World.SpawnScene(FFICTestSceneSize(NumCameras, 2), 9);
+	FRandomStream Random(9);
+	for (UObject* Object : Scene->GetSceneObjects()) {
+		UFICCamera* Camera = Cast<UFICCamera>(Object);
+		FFICFloatAttribute* Channels[] = {&Camera->Position.X, &Camera->Position.Y, &Camera->Position.Z, &Camera->Rotation.Pitch, &Camera->Rotation.Yaw, &Camera->Rotation.Roll, &Camera->FOV};
+		for (FFICFloatAttribute* Channel : Channels) {
+			Channel->LockUpdateEvent();
+			for (FICFrame Frame : TArray<FICFrame>(Channel->GetFrames())) Channel->RemoveKeyframe(Frame);
+		}
+		const int32 NumChannels = UE_ARRAY_COUNT(Channels);
+		for (int32 Key = 0; Key < Keys / NumCameras; ++Key) {
+			Channels[Key % NumChannels]->SetKeyframe((FICFrame)(Key / NumChannels) * 10, FFICFloatKeyframe(Random.FRandRange(-100000.0f, 100000.0f)));
+		}
+		for (FFICFloatAttribute* Channel : Channels) Channel->UnlockUpdateEvent();
+	}
+	return Scene;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFICSceneArchivePerfTest, "FicsItCam.Perf.SceneArchive", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+bool FFICSceneArchivePerfTest::RunTest(const FString& Parameters) {
+	FFICTestWorld World;
+	for (int32 Keys : {1000, 100000, 1000000}) {
+		AFICScene* Scene = SpawnArchiveScene(World, Keys);
+		// the baseline keys name the key count as cameras times keyframes per camera
+		FFICTestSceneSize Size(10, Keys / 10);
+		int32 Iterations = Keys < 1000000 ? 10 : 3;
+
+		TArray<uint8> Data;
+		double SaveNs = FFICPerfBaselines::Measure(Iterations, Keys, [&]() {
+			FFICSceneArchive::Save(Scene, Data);
+		});
+		AddInfo(FString::Printf(TEXT("%i keys take %i bytes (%.2f bytes per key)"), Keys, Data.Num(), (float)Data.Num() / Keys));
+		FFICPerfBaselines::Get().Check(*this, TEXT("SceneArchive.Save"), Size, SaveNs, 500.0);
+
+		bool bLoaded = true;
+		double LoadNs = FFICPerfBaselines::Measure(Iterations, Keys, [&]() {
+			bLoaded = FFICSceneArchive::Load(Scene, Data) && bLoaded;
+		});
+		TestTrue(TEXT("Scene data is readable"), bLoaded);
+		FFICPerfBaselines::Get().Check(*this, TEXT("SceneArchive.Load"), Size, LoadNs, 1000.0);
+
+		Scene->Destroy();
+	}
+	return true;
+}
+
+#endif
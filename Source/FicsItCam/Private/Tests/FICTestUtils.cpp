@@ -0,0 +1,135 @@
+#include "Tests/FICTestUtils.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Data/Objects/FICCamera.h"
+#include "Dom/JsonObject.h"
+#include "Interfaces/IPluginManager.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+
+FFICTestSceneSize FFICTestSceneSize::FromCommandLine() {
+	FFICTestSceneSize Size;
+	FParse::Value(FCommandLine::Get(), TEXT("FICTestCameras="), Size.Cameras);
+	FParse::Value(FCommandLine::Get(), TEXT("FICTestKeyframes="), Size.KeyframesPerCamera);
+	Size.Cameras = FMath::Max(Size.Cameras, 1);
+	Size.KeyframesPerCamera = FMath::Max(Size.KeyframesPerCamera, 2);
+	return Size;
+}
+
+TArray<UFICCamera*> FFICTestScene::CreateCameras(UObject* Outer, const FFICTestSceneSize& Size, int32 Seed) {
+	FRandomStream Random(Seed);
+	TArray<UFICCamera*> Cameras;
+	for (int32 i = 0; i < Size.Cameras; ++i) {
+		UFICCamera* Camera = NewObject<UFICCamera>(Outer);
+		Camera->SceneObjectName = FString::Printf(TEXT("Camera_%i"), i);
+		Cameras.Add(Camera);
+		if (i == Size.Cameras - 1) break;
+
+		Camera->Active.SetDefaultValue(false);
+		for (int32 Key = 0; Key < Size.KeyframesPerCamera; ++Key) {
+			FICFrame Frame = Random.RandRange(0, Size.GetLastFrame());
+			Camera->Active.SetKeyframe(Frame, FFICKeyframeBool(Random.GetFraction() < 0.3f));
+			Camera->Position.X.SetKeyframe(Frame, FFICFloatKeyframe(Random.FRandRange(-100000.0f, 100000.0f)));
+			Camera->Position.Y.SetKeyframe(Frame, FFICFloatKeyframe(Random.FRandRange(-100000.0f, 100000.0f)));
+			Camera->Position.Z.SetKeyframe(Frame, FFICFloatKeyframe(Random.FRandRange(0.0f, 50000.0f)));
+			Camera->Rotation.Yaw.SetKeyframe(Frame, FFICFloatKeyframe(Random.FRandRange(-720.0f, 720.0f)));
+			Camera->Rotation.Pitch.SetKeyframe(Frame, FFICFloatKeyframe(Random.FRandRange(-89.0f, 89.0f)));
+			Camera->FOV.SetKeyframe(Frame, FFICFloatKeyframe(Random.FRandRange(30.0f, 120.0f)));
+		}
+	}
+	return Cameras;
+}
+
+UObject* FFICTestScene::FindActiveCamera(const TArray<UObject*>& Cameras, FICFrameFloat Frame) {
+	for (UObject* Camera : Cameras) {
+		if (Cast<UFICCamera>(Camera)->Active.GetValue(Frame)) return Camera;
+	}
+	return nullptr;
+}
+
+FFICTestWorld::FFICTestWorld() {
+	World = UWorld::CreateWorld(EWorldType::Game, false, TEXT("FICTestWorld"));
+	World->AddToRoot();
+	FWorldContext& Context = GEngine->CreateNewWorldContext(EWorldType::Game);
+	Context.SetCurrentWorld(World);
+	World->InitializeActorsForPlay(FURL());
+}
+
+FFICTestWorld::~FFICTestWorld() {
+	GEngine->DestroyWorldContext(World);
+	World->DestroyWorld(false);
+	World->RemoveFromRoot();
+}
+
+AFICScene* FFICTestWorld::SpawnScene(const FFICTestSceneSize& Size, int32 Seed) {
+	AFICScene* Scene = World->SpawnActor<AFICScene>();
+	Scene->SceneName = TEXT("FICTestScene");
+	Scene->AnimationRange = FFICFrameRange(0, Size.GetLastFrame());
+	for (UFICCamera* Camera : FFICTestScene::CreateCameras(Scene, Size, Seed)) {
+		Scene->AddSceneObject(Camera);
+	}
+	return Scene;
+}
+
+FFICPerfBaselines& FFICPerfBaselines::Get() {
+	static FFICPerfBaselines Baselines;
+	return Baselines;
+}
+
+FFICPerfBaselines::FFICPerfBaselines() {
+	Path = FPaths::Combine(IPluginManager::Get().FindPlugin(TEXT("FicsItCam"))->GetBaseDir(), TEXT("Resources"), TEXT("Tests"), TEXT("PerfBaselines.json"));
+	FParse::Value(FCommandLine::Get(), TEXT("FICPerfTolerance="), Tolerance);
+	bUpdate = FParse::Param(FCommandLine::Get(), TEXT("FICUpdatePerfBaselines"));
+	bRequireBaselines = FParse::Param(FCommandLine::Get(), TEXT("FICRequirePerfBaselines"));
+
+	FString Json;
+	TSharedPtr<FJsonObject> Object;
+	if (!FFileHelper::LoadFileToString(Json, *Path) || !FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(Json), Object) || !Object) return;
+	for (const TPair<FString, TSharedPtr<FJsonValue>>& Entry : Object->Values) {
+		double Value;
+		if (Entry.Value->TryGetNumber(Value)) Baselines.Add(Entry.Key, Value);
+	}
+}
+
+void FFICPerfBaselines::Save() {
+	TSharedRef<FJsonObject> Object = MakeShared<FJsonObject>();
+	Baselines.KeySort(TLess<FString>());
+	for (const TPair<FString, double>& Baseline : Baselines) Object->SetNumberField(Baseline.Key, FMath::RoundToDouble(Baseline.Value * 10.0) / 10.0);
+	FString Json;
+	FJsonSerializer::Serialize(Object, TJsonWriterFactory<>::Create(&Json));
+	FFileHelper::SaveStringToFile(Json, *Path);
+}
+
+bool FFICPerfBaselines::Check(FAutomationTestBase& Test, const FString& Name, const FFICTestSceneSize& Size, double MeasuredNs, double BudgetNs) {
+	FString Key = FString::Printf(TEXT("%s@%s"), *Name, *Size.ToString());
+	Test.AddInfo(FString::Printf(TEXT("%s: %.1f ns/op (budget %.1f ns/op)"), *Key, MeasuredNs, BudgetNs));
+
+	if (bUpdate) {
+		Baselines.Add(Key, MeasuredNs);
+		Save();
+	}
+
+	if (MeasuredNs > BudgetNs) {
+		Test.AddError(FString::Printf(TEXT("%s took %.1f ns/op, exceeds its budget of %.1f ns/op"), *Key, MeasuredNs, BudgetNs));
+		return false;
+	}
+
+	double* Baseline = Baselines.Find(Key);
+	if (!Baseline) {
+		FString Message = FString::Printf(TEXT("%s has no stored baseline, run with -FICUpdatePerfBaselines to record one"), *Key);
+		if (bRequireBaselines && !bUpdate) {
+			Test.AddError(Message);
+			return false;
+		}
+		Test.AddWarning(Message);
+		return true;
+	}
+	if (MeasuredNs > *Baseline * (1.0 + Tolerance)) {
+		Test.AddError(FString::Printf(TEXT("%s took %.1f ns/op, regressed by more than %.0f%% from its baseline of %.1f ns/op"), *Key, MeasuredNs, Tolerance * 100.0f, *Baseline));
+		return false;
+	}
+	return true;
+}
+
+#endif
@@ -0,0 +1,97 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Data/FICScene.h"
+
+class UFICCamera;
+
+/**
+ * Size of the synthetic scenes used by the tests, configurable with -FICTestCameras=<n> and -FICTestKeyframes=<n>.
+ */
+struct FFICTestSceneSize {
+	int32 Cameras = 32;
+	int32 KeyframesPerCamera = 64;
+
+	FFICTestSceneSize() = default;
+	FFICTestSceneSize(int32 Cameras, int32 KeyframesPerCamera) : Cameras(Cameras), KeyframesPerCamera(KeyframesPerCamera) {}
+
+	/** Returns the size given on the command line, or the default size */
+	static FFICTestSceneSize FromCommandLine();
+
+	FFICTestSceneSize operator*(int32 Factor) const { return FFICTestSceneSize(Cameras * Factor, KeyframesPerCamera * Factor); }
+	FString ToString() const { return FString::Printf(TEXT("%ix%i"), Cameras, KeyframesPerCamera); }
+	/** Last frame keyframes get generated at */
+	FICFrame GetLastFrame() const { return (FICFrame)KeyframesPerCamera * 10; }
+};
+
+class FFICTestScene {
+public:
+	/**
+	 * Creates cameras with random active, position, rotation and FOV keyframes.
+	 * The last camera has no active keyframes and is always active, so a active camera exists at every frame.
+	 */
+	static TArray<UFICCamera*> CreateCameras(UObject* Outer, const FFICTestSceneSize& Size, int32 Seed);
+
+	/** Returns the first camera of the given cameras active at the given frame, by evaluating every active attribute */
+	static UObject* FindActiveCamera(const TArray<UObject*>& Cameras, FICFrameFloat Frame);
+};
+
+/**
+ * Game world created for a test, destroyed again with the object.
+ */
+class FFICTestWorld {
+public:
+	FFICTestWorld();
+	~FFICTestWorld();
+
+	UWorld* GetWorld() const { return World; }
+
+	/** Spawns a scene with synthetic cameras of the given size in the world */
+	AFICScene* SpawnScene(const FFICTestSceneSize& Size, int32 Seed);
+
+private:
+	UWorld* World = nullptr;
+};
+
+/**
+ * Performance check against stored baselines in Resources/Tests/PerfBaselines.json of the plugin.
+ * A measurement fails if it exceeds its budget, or its baseline by more than the tolerance (-FICPerfTolerance=<fraction>, 0.5 by default).
+ * Run with -FICUpdatePerfBaselines to store the measurements as new baselines.
+ * Missing baselines are warnings, with -FICRequirePerfBaselines (for CI runs) they fail the measurement.
+ */
+class FFICPerfBaselines {
+public:
+	static FFICPerfBaselines& Get();
+
+	/** Returns the median time of the given function in nanoseconds per operation */
+	template<typename FuncType>
+	static double Measure(int32 Iterations, int64 Operations, FuncType Func) {
+		TArray<double> Seconds;
+		for (int32 i = 0; i < Iterations; ++i) {
+			uint64 Start = FPlatformTime::Cycles64();
+			Func();
+			Seconds.Add(FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - Start));
+		}
+		Seconds.Sort();
+		return Seconds[Seconds.Num() / 2] * 1e9 / FMath::Max<int64>(Operations, 1);
+	}
+
+	/** Adds a error to the given test if the measurement regressed, returns false in that case */
+	bool Check(FAutomationTestBase& Test, const FString& Name, const FFICTestSceneSize& Size, double MeasuredNs, double BudgetNs);
+
+private:
+	FString Path;
+	TMap<FString, double> Baselines;
+	float Tolerance = 0.5f;
+	bool bUpdate = false;
+	bool bRequireBaselines = false;
+
+	FFICPerfBaselines();
+	void Save();
+};
+
+#endif
@@ -13,7 +13,7 @@ public:
 		bFinal = true;
 		ParentCommand = UFICCommandFeed::StaticClass();
 		CommandName = TEXT("create");
-		CommandSyntax = TEXT("/fic feed create <camera>");
+		CommandSyntax = TEXT("/fic feed create <camera> [captures per second] [resolution scale]");
 	}
 	
 	virtual EExecutionStatus ExecuteCommand(UCommandSender* InSender, TArray<FString> InArgs) override {
@@ -29,6 +29,8 @@ public:
 		TArray<FString> CamArgs = InArgs;
 		CamArgs.RemoveAt(0);
 		Process->CameraArgument = FFICCameraArgument::FromCli(InSender, CameraRef, CameraName, CamArgs);
+		Process->TargetCaptureRate = InArgs.Num() > 1 ? FCString::Atof(*InArgs[1]) : UFICRuntimeProcessCameraFeed::DefaultCaptureRate;
+		if (InArgs.Num() > 2) Process->ResolutionScale = FMath::Clamp(FCString::Atof(*InArgs[2]), 0.01f, 1.0f);
 		if (!SubSys->CreateRuntimeProcess(Key, Process)) {
 			InSender->SendChatMessage(FString::Printf(TEXT("Unable to create Feed for '%s'!"), *InArgs[0]), FColor::Red);
 			return EExecutionStatus::UNCOMPLETED;
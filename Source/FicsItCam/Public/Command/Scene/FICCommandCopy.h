@@ -25,7 +25,7 @@ public:
 			return EExecutionStatus::BAD_ARGUMENTS;
 		}
 		AFICScene* NewScene = InSender->GetWorld()->SpawnActor<AFICScene>();
-		NewScene->SceneName = InArgs[1];
+		NewScene->SetSceneName(InArgs[1]);
 		NewScene->AnimationRange = OldScene->AnimationRange;
 		NewScene->FPS = OldScene->FPS;
 		NewScene->ResolutionHeight = OldScene->ResolutionHeight;
@@ -34,6 +34,7 @@ public:
 		NewScene->bBulletTime = OldScene->bBulletTime;
 		NewScene->bUseCinematic = OldScene->bUseCinematic;
 		NewScene->bLooping = OldScene->bLooping;
+		NewScene->bMultiCameraRender = OldScene->bMultiCameraRender;
 		NewScene->LastCameraTransform = OldScene->LastCameraTransform;
 		NewScene->bViewportEverSaved = OldScene->bViewportEverSaved;
 		for (UObject* OldSceneObject : OldScene->GetSceneObjects()) {
@@ -30,7 +30,7 @@ public:
 		FIntPoint Resolution = UFGGameUserSettings::GetFGGameUserSettings()->GetScreenResolution();
 		Scene->ResolutionWidth = Resolution.X;
 		Scene->ResolutionHeight = Resolution.Y;
-		Scene->SceneName = InArgs[0];
+		Scene->SetSceneName(InArgs[0]);
 		UFICCamera* CDO = UFICCamera::StaticClass()->GetDefaultObject<UFICCamera>();
 		if (CDO) Scene->AddSceneObject(CDO->CreateNewObject(AFICSubsystem::GetFICSubsystem(InSender), Scene));
 		
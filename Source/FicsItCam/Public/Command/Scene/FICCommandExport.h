@@ -0,0 +1,33 @@
+#pragma once
+
+#include "Command/FICCommand.h"
+#include "Data/FICSceneFile.h"
+#include "FICCommandExport.generated.h"
+
+UCLASS()
+class UFICCommandExport : public UFICCommand {
+	GENERATED_BODY()
+public:
+	UFICCommandExport() {
+		bFinal = true;
+		CommandName = TEXT("export");
+		CommandSyntax = TEXT("/fic export <scene> <file>");
+	}
+	
+	virtual EExecutionStatus ExecuteCommand(UCommandSender* InSender, TArray<FString> InArgs) override {
+		CheckArgCount(2)
+		TryGetSceneFromArg(Scene, 0)
+		FString Path;
+		FString Error;
+		if (!FFICSceneFile::ResolvePath(InArgs[1], Path, Error)) {
+			InSender->SendChatMessage(Error + TEXT("!"), FColor::Red);
+			return EExecutionStatus::BAD_ARGUMENTS;
+		}
+		if (!FFICSceneFile::Export(Scene, Path, Error)) {
+			InSender->SendChatMessage(FString::Printf(TEXT("Failed to export scene '%s': %s"), *InArgs[0], *Error), FColor::Red);
+			return EExecutionStatus::UNCOMPLETED;
+		}
+		InSender->SendChatMessage(FString::Printf(TEXT("Scene '%s' exported to '%s'."), *InArgs[0], *Path), FColor::Green);
+		return EExecutionStatus::COMPLETED;
+	}
+};
@@ -0,0 +1,48 @@
+#pragma once
+
+#include "FICUtils.h"
+#include "Command/FICCommand.h"
+#include "Data/FICSceneFile.h"
+#include "FICCommandImport.generated.h"
+
+UCLASS()
+class UFICCommandImport : public UFICCommand {
+	GENERATED_BODY()
+public:
+	UFICCommandImport() {
+		bFinal = true;
+		CommandName = TEXT("import");
+		CommandSyntax = TEXT("/fic import <file> [scene name]");
+	}
+	
+	virtual EExecutionStatus ExecuteCommand(UCommandSender* InSender, TArray<FString> InArgs) override {
+		CheckArgCount(1)
+		FString Path;
+		FString Error;
+		if (!FFICSceneFile::ResolvePath(InArgs[0], Path, Error)) {
+			InSender->SendChatMessage(Error + TEXT("!"), FColor::Red);
+			return EExecutionStatus::BAD_ARGUMENTS;
+		}
+		FString SceneName;
+		if (InArgs.Num() > 1) {
+			SceneName = InArgs[1];
+		} else if (!FFICSceneFile::ReadSceneName(Path, SceneName)) {
+			InSender->SendChatMessage(FString::Printf(TEXT("Unable to read scene file '%s'!"), *Path), FColor::Red);
+			return EExecutionStatus::BAD_ARGUMENTS;
+		}
+		if (!UFICUtils::IsValidFICObjectName(SceneName)) {
+			InSender->SendChatMessage(FString::Printf(TEXT("'%s' is no valid scene name!"), *SceneName));
+			return EExecutionStatus::BAD_ARGUMENTS;
+		}
+		if (AFICSubsystem::GetFICSubsystem(InSender)->FindSceneByName(SceneName)) {
+			InSender->SendChatMessage(FString::Printf(TEXT("Scene '%s' already exists!"), *SceneName));
+			return EExecutionStatus::BAD_ARGUMENTS;
+		}
+		if (!FFICSceneFile::Import(InSender, Path, SceneName, Error)) {
+			InSender->SendChatMessage(FString::Printf(TEXT("Failed to import scene: %s"), *Error), FColor::Red);
+			return EExecutionStatus::UNCOMPLETED;
+		}
+		InSender->SendChatMessage(FString::Printf(TEXT("Scene '%s' imported from '%s'."), *SceneName, *Path), FColor::Green);
+		return EExecutionStatus::COMPLETED;
+	}
+};
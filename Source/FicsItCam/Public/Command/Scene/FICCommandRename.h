@@ -24,7 +24,7 @@ public:
 			InSender->SendChatMessage(FString::Printf(TEXT("Scene '%s' already exists!"), *InArgs[1]));
 			return EExecutionStatus::BAD_ARGUMENTS;
 		}
-		OldScene->SceneName = InArgs[1];
+		OldScene->SetSceneName(InArgs[1]);
 		InSender->SendChatMessage(FString::Printf(TEXT("Scene '%s' renamed to '%s'."), *InArgs[0], *InArgs[1]), FColor::Green);
 		return EExecutionStatus::COMPLETED;
 	}
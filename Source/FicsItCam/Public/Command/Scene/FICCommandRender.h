@@ -11,7 +11,7 @@ public:
 	UFICCommandRender() {
 		bFinal = true;
 		CommandName = TEXT("render");
-		CommandSyntax = TEXT("/fic render <scene>");
+		CommandSyntax = TEXT("/fic render <scene> [output scale] [write proxy] [rgba|bgra|yuv420] [motion blur samples]");
 	}
 	
 	virtual EExecutionStatus ExecuteCommand(UCommandSender* InSender, TArray<FString> InArgs) override {
@@ -23,6 +23,32 @@ public:
 		CheckSceneUsage(SubSys, EditSubSys, Key, Scene->SceneName)
 		UFICRuntimeProcessRenderScene* Process = NewObject<UFICRuntimeProcessRenderScene>(SubSys);
 		Process->Scene = Scene;
+		if (InArgs.Num() > 1) {
+			float Scale = FCString::Atof(*InArgs[1]);
+			if (Scale <= 0.0f || Scale > 1.0f) {
+				InSender->SendChatMessage(TEXT("Output scale has to be greater than 0 and at most 1."), FColor::Red);
+				return EExecutionStatus::BAD_ARGUMENTS;
+			}
+			Process->OutputSettings.Size = FIntPoint(FMath::Max(1, FMath::RoundToInt(Scene->ResolutionWidth * Scale)), FMath::Max(1, FMath::RoundToInt(Scene->ResolutionHeight * Scale)));
+		}
+		TryGetBoolFromArgOpt(bWriteProxy, false, 2)
+		Process->OutputSettings.bWriteProxy = bWriteProxy;
+		if (InArgs.Num() > 3) {
+			if (InArgs[3] == TEXT("bgra")) Process->OutputSettings.Format = EFICImageFormat::BGRA;
+			else if (InArgs[3] == TEXT("yuv420")) Process->OutputSettings.Format = EFICImageFormat::YUV420;
+			else if (InArgs[3] != TEXT("rgba")) {
+				InSender->SendChatMessage(FString::Printf(TEXT("Unknown output format '%s'!"), *InArgs[3]), FColor::Red);
+				return EExecutionStatus::BAD_ARGUMENTS;
+			}
+		}
+		if (InArgs.Num() > 4) {
+			int32 Samples = FCString::Atoi(*InArgs[4]);
+			if (Samples < 1 || Samples > 64) {
+				InSender->SendChatMessage(TEXT("Motion blur samples have to be between 1 and 64."), FColor::Red);
+				return EExecutionStatus::BAD_ARGUMENTS;
+			}
+			Process->MotionBlurSamples = Samples;
+		}
 		SubSys->CreateRuntimeProcess(Key, Process, true);
 		return EExecutionStatus::COMPLETED;
 	}
@@ -13,7 +13,7 @@ public:
 		bFinal = true;
 		ParentCommand = UFICCommandTimelapse::StaticClass();
 		CommandName = TEXT("create");
-		CommandSyntax = TEXT("/fic timelapse create <camera> <seconds per frame as float>");
+		CommandSyntax = TEXT("/fic timelapse create <camera> <seconds per frame as float> [skip unchanged frames below difference as float]");
 	}
 	
 	virtual EExecutionStatus ExecuteCommand(UCommandSender* InSender, TArray<FString> InArgs) override {
@@ -31,6 +31,10 @@ public:
 		CamArgs.RemoveAt(0);
 		Process->CameraArgument = FFICCameraArgument::FromCli(InSender, CameraRef, CameraName, CamArgs);
 		Process->SecondsPerFrame = SPF;
+		if (InArgs.Num() > 2) {
+			Process->bSkipUnchangedFrames = true;
+			Process->ChangeThreshold = FMath::Clamp(FCString::Atof(*InArgs[2]), 0.0f, 1.0f);
+		}
 		if (!SubSys->CreateRuntimeProcess(Key, Process)) {
 			InSender->SendChatMessage(FString::Printf(TEXT("Unable to create Timelapse for '%s'!"), *InArgs[0]), FColor::Red);
 			return EExecutionStatus::UNCOMPLETED;
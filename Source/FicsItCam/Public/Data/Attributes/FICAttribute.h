@@ -1,5 +1,6 @@
 #pragma once
 
+#include "FICFrameIndex.h"
 #include "FICKeyframe.h"
 #include "Editor/Data/FICEditorAttributeBase.h"
 #include "FICAttribute.generated.h"
@@ -10,11 +11,22 @@ struct FFICAttribute {
 
 private:
 	int UpdateLocks = 0;
+	uint32 Revision = 0;
+	
+	static uint32 RevisionCounter;
 
 protected:
+	TSet<FICFrame> DirtyKeyframes;
+	
 	void OnUpdateBroadcast() {
+		MarkChanged();
 		if (UpdateLocks == 0) OnUpdate.Broadcast(); 
 	}
+
+	/**
+	 * Gives the attribute a new revision, used for changes that don't broadcast a update (like loading keyframes).
+	 */
+	void MarkChanged() { Revision = ++RevisionCounter; }
 	
 public:
 	DECLARE_MULTICAST_DELEGATE(FOnUpdate)
@@ -30,6 +42,12 @@ public:
 	}
 
 	virtual ~FFICAttribute() = default;
+
+	/**
+	 * Returns a stamp that changes with every change of the attribute, unique across all attributes.
+	 * Allows to cache data derived from the keyframes without listening to the update event.
+	 */
+	uint32 GetRevision() const { return Revision; }
 	
 	virtual FName GetAttributeType() const { checkf(false, TEXT("Not Implemented!")); return FName(); }
 	
@@ -46,10 +64,44 @@ public:
 
 	virtual TSharedRef<FFICEditorAttributeBase> CreateEditorAttribute() { checkf(false, TEXT("Not Implemented!")); return MakeShareable<FFICEditorAttributeBase>(nullptr); }
 
+	/**
+	 * Returns the child attributes of this attribute, attributes without children hold the actual keyframes.
+	 */
+	virtual TMap<FString, FFICAttribute*> GetChildAttributes() { return TMap<FString, FFICAttribute*>(); }
+
+	/**
+	 * Returns the approximate amount of memory used by this attribute in bytes, mainly used to weigh snapshots.
+	 */
+	virtual SIZE_T GetAllocatedSize() const { return sizeof(FFICAttribute); }
+
+	/**
+	 * Reads or writes the keyframes of this attribute in the compact scene format (see FFICSceneArchive).
+	 * Only attributes without children hold keyframes.
+	 */
+	virtual void SerializeKeyframes(FArchive& Ar) {}
+
+	/**
+	 * Moves the keyframes out of the reflected properties while a save game gets written,
+	 * as they are already stored in the compact scene data.
+	 */
+	virtual void StashKeyframes() {}
+	virtual void UnstashKeyframes() {}
+
 	void RecalculateAllKeyframes();
 
-	// TODO: Use Binary-Search
-	TSharedPtr<FFICKeyframe> GetNextKeyframe(FICFrame Time, FICFrame& OutTime);
-	TSharedPtr<FFICKeyframe> GetPrevKeyframe(FICFrame Time, FICFrame& OutTime);
+	/**
+	 * Marks the keyframe at the given frame as changed, so it and its neighbours get recalculated on the next RecalculateDirtyKeyframes.
+	 * The frame may also be of a removed keyframe, then only the neighbours get recalculated.
+	 */
+	virtual void MarkKeyframeDirty(FICFrame Time) { DirtyKeyframes.Add(Time); MarkChanged(); }
+
+	/**
+	 * Recalculates only the keyframes marked as dirty and their direct neighbours,
+	 * as the automatic controls of a keyframe only depend on the adjacent keyframes.
+	 */
+	virtual void RecalculateDirtyKeyframes();
+
+	virtual TSharedPtr<FFICKeyframe> GetNextKeyframe(FICFrame Time, FICFrame& OutTime);
+	virtual TSharedPtr<FFICKeyframe> GetPrevKeyframe(FICFrame Time, FICFrame& OutTime);
 };
 
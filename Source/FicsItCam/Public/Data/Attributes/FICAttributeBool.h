@@ -30,6 +30,9 @@ struct FFICAttributeBool : public FFICAttribute {
 private:
 	UPROPERTY(SaveGame)
 	TMap<int64, FFICKeyframeBool> Keyframes;
+	TMap<int64, FFICKeyframeBool> StashedKeyframes;
+
+	FFICFrameIndex FrameIndex;
 
 public:
 	UPROPERTY(SaveGame)
@@ -45,11 +48,17 @@ public:
 	virtual void MoveKeyframe(FICFrame From, FICFrame To) override;
 	virtual void RecalculateKeyframe(FICFrame Time) override;
 	virtual FICValue GetFloatValue(FICFrameFloat Time) override;
+	virtual TSharedPtr<FFICKeyframe> GetNextKeyframe(FICFrame Time, FICFrame& OutTime) override;
+	virtual TSharedPtr<FFICKeyframe> GetPrevKeyframe(FICFrame Time, FICFrame& OutTime) override;
 	
 	virtual void Set(TSharedRef<FFICAttribute> InAttrib) override;
 	virtual TSharedRef<FFICAttribute> Get() override;
 
 	virtual TSharedRef<FFICEditorAttributeBase> CreateEditorAttribute() override;
+	virtual SIZE_T GetAllocatedSize() const override { return sizeof(FFICAttributeBool) + Keyframes.GetAllocatedSize(); }
+	virtual void SerializeKeyframes(FArchive& Ar) override;
+	virtual void StashKeyframes() override { StashedKeyframes = MoveTemp(Keyframes); }
+	virtual void UnstashKeyframes() override { Keyframes = MoveTemp(StashedKeyframes); MarkChanged(); }
 	// End FFICAttribute
 
 	FFICKeyframeBool* SetKeyframe(FICFrame Time, FFICKeyframeBool Keyframe);
@@ -70,7 +79,7 @@ public:
 	FFICKeyframeBool* GetKeyframe() const { if (this) return &Attribute->Keyframes[Frame]; return nullptr; }
 	
 	virtual FICValue GetValue() const override { return GetKeyframe()->GetValue(); }
-	virtual void SetValue(FICValue InValue) override { GetKeyframe()->SetValue(InValue); }
+	virtual void SetValue(FICValue InValue) override { GetKeyframe()->SetValue(InValue); Attribute->MarkKeyframeDirty(Frame); }
 	virtual FFICValueTimeFloat GetInControl() override {
 		return GetKeyframe()->GetInControl();
 	}
@@ -84,5 +93,5 @@ public:
 		GetKeyframe()->SetOutControl(InOutControl);
 	}
 	virtual EFICKeyframeType GetType() override { return GetKeyframe()->GetType(); }
-	virtual void SetType(EFICKeyframeType InType) override { return GetKeyframe()->SetType(InType); }
+	virtual void SetType(EFICKeyframeType InType) override { GetKeyframe()->SetType(InType); Attribute->MarkKeyframeDirty(Frame); }
 };
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "FICAttribute.h"
+#include "FICCurve.h"
 #include "FICAttributeFloat.generated.h"
 
 // TODO: Rename to FFICKeyframeFloat
@@ -47,6 +48,10 @@ public:
 private:
 	UPROPERTY(SaveGame)
 	TMap<int64, FFICFloatKeyframe> Keyframes;
+	TMap<int64, FFICFloatKeyframe> StashedKeyframes;
+
+	FFICFrameIndex FrameIndex;
+	int32 SegmentCursor = 0;
 
 public:
 	UPROPERTY(SaveGame)
@@ -62,18 +67,30 @@ public:
 	virtual void MoveKeyframe(FICFrame From, FICFrame To) override;
 	virtual void RecalculateKeyframe(FICFrame Time) override;
 	virtual FICValue GetFloatValue(FICFrameFloat Time) override;
+	virtual TSharedPtr<FFICKeyframe> GetNextKeyframe(FICFrame Time, FICFrame& OutTime) override;
+	virtual TSharedPtr<FFICKeyframe> GetPrevKeyframe(FICFrame Time, FICFrame& OutTime) override;
 
 	virtual void Set(TSharedRef<FFICAttribute> InAttrib) override;
 	virtual TSharedRef<FFICAttribute> Get() override;
 
 	virtual TSharedRef<FFICEditorAttributeBase> CreateEditorAttribute() override;
+	virtual SIZE_T GetAllocatedSize() const override { return sizeof(FFICFloatAttribute) + Keyframes.GetAllocatedSize(); }
+	virtual void SerializeKeyframes(FArchive& Ar) override;
+	virtual void StashKeyframes() override { StashedKeyframes = MoveTemp(Keyframes); }
+	virtual void UnstashKeyframes() override { Keyframes = MoveTemp(StashedKeyframes); MarkChanged(); }
 	// End FFICAttribute
 
 	virtual FFICFloatKeyframe* GetKeyframe(FICFrame Time) { return Keyframes.Find(Time); }
+	/** Returns the sorted frames of all keyframes */
+	const TArray<FICFrame>& GetFrames() { return FrameIndex.Get(Keyframes); }
 	
 	FFICFloatKeyframe* SetKeyframe(FICFrame Time, FFICFloatKeyframe Keyframe);
 	float GetValue(FICFrameFloat Time);
 	void SetDefaultValue(float Value) { FallBackValue = Value; }
+
+	/** Maps keyframes to the curve math of FicsItCamMath, ease keyframes get auto tangents and ease-in-out keyframes flat tangents */
+	static EFICCurveInterpolation ToCurveInterpolation(EFICKeyframeType Type);
+	static FFICCurveKey ToCurveKey(const FFICFloatKeyframe& Keyframe);
 };
 
 class FFICFloatKeyframeTrampoline : public FFICKeyframe {
@@ -87,7 +104,7 @@ public:
 	FFICFloatKeyframe* GetKeyframe() const { if (this) return &Attribute->Keyframes[Frame]; return nullptr; }
 	
 	virtual FICValue GetValue() const override { return GetKeyframe()->GetValue(); }
-	virtual void SetValue(FICValue InValue) override { GetKeyframe()->SetValue(InValue); }
+	virtual void SetValue(FICValue InValue) override { GetKeyframe()->SetValue(InValue); Attribute->MarkKeyframeDirty(Frame); }
 	virtual FFICValueTimeFloat GetInControl() override {
 		return GetKeyframe()->GetInControl();
 	}
@@ -101,5 +118,5 @@ public:
 		GetKeyframe()->SetOutControl(InOutControl);
 	}
 	virtual EFICKeyframeType GetType() override { return GetKeyframe()->GetType(); }
-	virtual void SetType(EFICKeyframeType InType) override { return GetKeyframe()->SetType(InType); }
+	virtual void SetType(EFICKeyframeType InType) override { GetKeyframe()->SetType(InType); Attribute->MarkKeyframeDirty(Frame); }
 };
@@ -54,6 +54,10 @@ public:
 	virtual TSharedRef<FFICAttribute> Get() override;
 
 	virtual TSharedRef<FFICEditorAttributeBase> CreateEditorAttribute() override;
+	virtual TMap<FString, FFICAttribute*> GetChildAttributes() override { return Children; }
+	virtual SIZE_T GetAllocatedSize() const override;
+	virtual void MarkKeyframeDirty(FICFrame Time) override;
+	virtual void RecalculateDirtyKeyframes() override;
 	// End FFICAttribute
 
 	void AddChildAttribute(FString Name, FFICAttribute* Attribute);
@@ -10,7 +10,26 @@ class FFICEditorAttributeGroup;
 USTRUCT(BlueprintType)
 struct FFICAttributeRotation : public FFICGroupAttribute {
 	GENERATED_BODY()
+private:
+	/**
+	 * Quaternion keys and squad tangents at the keyframes of the channels and in between keyframes turning more than half a turn,
+	 * rebuilt when the revision of a channel changed.
+	 */
+	struct FQuatKeys {
+		TArray<FICFrameFloat> Frames;
+		TArray<FQuat> Keys;
+		TArray<FQuat> Tangents;
+		TArray<EFICKeyframeType> Types;
+		uint32 Revisions[3] = {0, 0, 0};
+		int32 SegmentCursor = 0;
+		bool bValid = false;
+	} QuatKeys;
+
+	void UpdateQuatKeys();
+	
 public:
+	inline static const FName TypeName = FName(TEXT("RotationAttribute"));
+	
 	UPROPERTY(SaveGame)
 	FFICFloatAttribute Pitch;
 	
@@ -20,6 +39,13 @@ public:
 	UPROPERTY(SaveGame)
 	FFICFloatAttribute Roll;
 
+	/**
+	 * If set, the rotation gets interpolated as quaternion (squad) between the keyframes of the channels
+	 * instead of interpolating pitch, yaw and roll independently.
+	 */
+	UPROPERTY(SaveGame)
+	bool bQuaternionInterpolation = false;
+
 	FFICAttributeRotation() {
 		AddChildAttribute("Pitch", &Pitch);
 		AddChildAttribute("Yaw", &Yaw);
@@ -27,10 +53,12 @@ public:
 	}
 
 	// Begin FFICAttribute
+	virtual FName GetAttributeType() const override { return TypeName; }
 	virtual TSharedRef<FFICEditorAttributeBase> CreateEditorAttribute() override;
 	// End FFICAttribute
 
 	FRotator Get(FICFrameFloat Frame) {
+		if (bQuaternionInterpolation) return GetQuat(Frame).Rotator();
 		return FRotator(
 			Pitch.GetValue(Frame),
 			Yaw.GetValue(Frame),
@@ -38,6 +66,8 @@ public:
 		);
 	}
 
+	FQuat GetQuat(FICFrameFloat Frame);
+
 	void SetDefaultValue(const FRotator& Rot) {
 		Pitch.SetDefaultValue(Rot.Pitch);
 		Yaw.SetDefaultValue(Rot.Yaw);
@@ -45,5 +75,9 @@ public:
 	}
 
 	static FRotator FromEditorAttribute(FFICEditorAttributeGroup& Attribute);
+	/**
+	 * Like FromEditorAttribute, but uses the quaternion interpolation of the attribute at the given frame if enabled and the values didn't get changed.
+	 */
+	static FRotator FromEditorAttribute(FFICEditorAttributeGroup& Attribute, FICFrame Time);
 	static void ToEditorAttribute(const FRotator& Rotator, FFICEditorAttributeGroup& Attribute);
 };
\ No newline at end of file
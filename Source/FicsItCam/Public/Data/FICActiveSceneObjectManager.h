@@ -1,5 +1,6 @@
 #pragma once
 
+#include "FICActiveTimeline.h"
 #include "FICScene.h"
 
 DECLARE_DELEGATE_RetVal_TwoParams(bool, FFICISceneObjectActive, UObject*, FICFrameFloat)
@@ -9,10 +10,35 @@ private:
 	TMap<FString, UObject*> ActiveSceneObjects;
 	AFICScene* Scene = nullptr;
 
+	bool bCandidatesValid = false;
+	bool bTimelinesValid = false;
+	TMap<FString, TArray<UObject*>> Candidates;
+	TMap<FString, FFICActiveTimeline> Timelines;
+	TArray<TPair<FFICAttribute*, FDelegateHandle>> UpdateDelegateHandles;
+
+	void BuildCandidates();
+	
 public:
+	/**
+	 * If bound, used to check if a scene object is active at the given frame (f.e. to respect not yet keyframed changes in the editor).
+	 * Otherwise the active objects get resolved from timelines of the active attributes.
+	 */
 	FFICISceneObjectActive IsSceneObjectActive;
 	
 	void Initialize(AFICScene* InScene);
 	void UpdateActiveObjects(FICFrameFloat Frame);
+	/** Returns the scene object of the given active type activated by the last update, nullptr if none is active */
+	UObject* GetActiveSceneObject(const FString& InActiveType) const { return ActiveSceneObjects.FindRef(InActiveType); }
+	/** Returns the amount of update delegates the manager registered on active attributes */
+	int32 GetNumUpdateDelegates() const { return UpdateDelegateHandles.Num(); }
+	/**
+	 * Deactivates all active scene objects and removes all delegates of the manager.
+	 * Updates are ignored until the manager gets initialized again.
+	 */
 	void Shutdown();
+
+	/**
+	 * Has to be called when scene objects got added, removed or reordered.
+	 */
+	void Invalidate();
 };
@@ -0,0 +1,45 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "FICTypes.h"
+
+/**
+ * Precomputed active scene object of a active type over the whole animation.
+ * As the active attributes are step-only bool attributes, the active object can only change at their keyframes.
+ */
+struct FICSITCAM_API FFICActiveTimeline {
+	/** Frames at which the active object changes */
+	TArray<FICFrame> Breakpoints;
+	/** Active scene object of each segment between the breakpoints, the first entry is active before the first breakpoint */
+	TArray<UObject*> Segments;
+
+	/**
+	 * Iterates over the cuts of the timeline, a cut is a frame at which the active object changes.
+	 * The first cut is at the lowest possible frame and refers to the object active before the first breakpoint.
+	 */
+	class FCutIterator {
+	public:
+		FCutIterator(const FFICActiveTimeline& Timeline) : Timeline(Timeline) {}
+
+		FICFrame GetFrame() const { return Index > 0 ? Timeline.Breakpoints[Index-1] : TNumericLimits<FICFrame>::Lowest(); }
+		UObject* GetObject() const { return Timeline.Segments[Index]; }
+		
+		FCutIterator& operator++() {
+			++Index;
+			return *this;
+		}
+		explicit operator bool() const { return Timeline.Segments.IsValidIndex(Index); }
+
+	private:
+		const FFICActiveTimeline& Timeline;
+		int32 Index = 0;
+	};
+
+	/**
+	 * Builds the timeline from the given candidates, the first active candidate of a segment is the active object.
+	 */
+	void Build(const TArray<UObject*>& Candidates);
+	UObject* Resolve(FICFrameFloat Frame) const;
+	
+	FCutIterator CreateCutIterator() const { return FCutIterator(*this); }
+};
@@ -98,7 +98,7 @@ public:
 		
 		Scene->AddSceneObject(Camera);
 
-		Scene->SceneName = Name;
+		Scene->SetSceneName(Name);
 		
 		Scene->AnimationRange.Begin = AnimationStart;
 		Scene->AnimationRange.End = AnimationEnd;
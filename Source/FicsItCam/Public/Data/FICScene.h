@@ -2,6 +2,7 @@
 
 #include "CoreMinimal.h"
 #include "FGSaveInterface.h"
+#include "FICActiveTimeline.h"
 #include "FICTypes.h"
 #include "Objects/FICCamera.h"
 #include "FICScene.generated.h"
@@ -13,7 +14,33 @@ private:
 	UPROPERTY(SaveGame)
 	TArray<UObject*> SceneObjects;
 
+	/**
+	 * Keyframes of all scene objects in the compact format of FFICSceneArchive.
+	 * Only filled while saving and loading, saves without it still have the keyframes in the attributes.
+	 */
+	UPROPERTY(SaveGame)
+	TArray<uint8> SceneData;
+
+	bool bCameraTimelineValid = false;
+	FFICActiveTimeline CameraTimeline;
+	TArray<TPair<FFICAttribute*, FDelegateHandle>> CameraUpdateDelegateHandles;
+
+	/**
+	 * Rebuilds the camera timeline if it got invalidated and subscribes to the active attributes of the cameras.
+	 */
+	void UpdateCameraTimeline();
+
+	bool bSceneObjectIndexValid = false;
+	TMap<FString, UObject*> SceneObjectIndex;
+	/** Next suffix to try per base name when creating unique scene object names */
+	TMap<FString, int32> NextNameSuffix;
+
+	void BuildSceneObjectIndex();
+	/** Lowers the next suffix of the name's base name if the freed name has a lower suffix, so freed suffixes get reused */
+	void ReleaseSceneObjectName(const FString& InName);
+
 public:
+	/** Use SetSceneName to change the name, so the scene stays findable by its name */
 	UPROPERTY(SaveGame)
 	FString SceneName = "Unnamed";
 	
@@ -40,6 +67,9 @@ public:
 	UPROPERTY(SaveGame)
 	bool bLooping = false;
 
+	UPROPERTY(SaveGame)
+	bool bMultiCameraRender = false;
+
 	UPROPERTY(SaveGame)
 	FTransform LastCameraTransform;
 	UPROPERTY()
@@ -52,23 +82,48 @@ public:
 	// Begin IFGSaveInterface
 	//virtual void GatherDependencies_Implementation(TArray<UObject*>& out_dependentObjects) override { out_dependentObjects.Append(SceneObjects); }
 	virtual bool ShouldSave_Implementation() const override { return true; }
+	virtual void PreSaveGame_Implementation(int32 saveVersion, int32 gameVersion) override;
+	virtual void PostSaveGame_Implementation(int32 saveVersion, int32 gameVersion) override;
 	virtual void PostLoadGame_Implementation(int32 saveVersion, int32 gameVersion) override;
 	// End IFGSaveInterface
+
+	// Begin AActor
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+	// End AActor
 	
 	TArray<UObject*> GetSceneObjects() {
 		return SceneObjects;
 	}
 
-	void AddSceneObject(UObject* Object) {
-		check(Object->Implements<UFICSceneObject>());
-		SceneObjects.Add(Object);
-	}
-
-	void RemoveSceneObject(UObject* Object) {
-		SceneObjects.Remove(Object);
-	}
+	void AddSceneObject(UObject* Object);
+	void RemoveSceneObject(UObject* Object);
 
 	void MoveSceneObject(UObject* Object, int Delta);
 
 	UFICCamera* GetActiveCamera(FICFrameFloat Time);
+
+	/**
+	 * Allows to iterate over the frames at which the active camera changes.
+	 * The iterator is invalidated when the scene objects or the active attribute of a camera change.
+	 */
+	FFICActiveTimeline::FCutIterator CreateCameraCutIterator();
+
+	/**
+	 * Forces the camera timeline to be rebuilt on its next use.
+	 * Changes of the active attributes and the scene object order are detected automatically.
+	 */
+	void InvalidateCameraTimeline();
+
+	void SetSceneName(const FString& InSceneName);
+
+	UObject* FindSceneObject(const FString& InSceneObjectName);
+	/**
+	 * Renames the given scene object, the name is not made unique.
+	 */
+	void RenameSceneObject(UObject* Object, const FString& InSceneObjectName);
+	/**
+	 * Returns the given name, or if already used, the given name with the next free numeric suffix.
+	 */
+	FString MakeUniqueSceneObjectName(const FString& InBaseName);
 };
@@ -0,0 +1,61 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "FICEncoding.h"
+#include "Data/FICTypes.h"
+#include "Data/Attributes/FICKeyframe.h"
+
+class AFICScene;
+class IFICSceneObject;
+struct FFICAttribute;
+
+/**
+ * Compact binary format for the keyframes of all scene objects of a scene, stored as one blob per scene.
+ *
+ * Layout: magic, version, scene object count, then per scene object (in scene order) its name and leaf attribute count,
+ * then per leaf attribute its path, type and a size prefixed block written by FFICAttribute::SerializeKeyframes.
+ * Blocks of unknown attributes are skipped on load.
+ */
+class FICSITCAM_API FFICSceneArchive {
+public:
+	static constexpr uint32 Magic = 0x53434946; // "FICS"
+
+	enum EVersion : uint32 {
+		VERSION_INITIAL = 1,
+		
+		VERSION_LATEST = VERSION_INITIAL,
+	};
+	
+	static void Save(AFICScene* Scene, TArray<uint8>& OutData);
+	/**
+	 * Replaces the keyframes of the scene objects with the ones stored in the data.
+	 * Returns false if the data is not readable, then the keyframes are kept as they are.
+	 */
+	static bool Load(AFICScene* Scene, const TArray<uint8>& Data);
+
+	/**
+	 * Writes the leaf attribute count followed by the size prefixed keyframe blocks of the given scene object.
+	 */
+	static void SaveSceneObjectKeyframes(FArchive& Ar, IFICSceneObject* SceneObject);
+	/**
+	 * Reads the keyframes written by SaveSceneObjectKeyframes, if the scene object is null, the keyframes are skipped.
+	 */
+	static void LoadSceneObjectKeyframes(FArchive& Ar, IFICSceneObject* SceneObject);
+
+	/**
+	 * Returns the index of the scene object the given keyframe block belongs to, or INDEX_NONE if there is none.
+	 * Blocks belong to the scene object at the same index if its name matches, otherwise to the first not yet loaded one with that name.
+	 */
+	static int32 FindSceneObject(const TArray<UObject*>& SceneObjects, const TBitArray<>& Loaded, const FString& Name, uint64 BlockIndex);
+
+	/**
+	 * Calls the given function for every attribute of the given attribute tree that has no children.
+	 */
+	static void ForEachLeafAttribute(FFICAttribute& Root, TFunctionRef<void(const FString& Path, FFICAttribute& Attribute)> Func);
+
+	// Begin Encoding Helpers
+	/** Keyframe types as 3-bit index, the other encodings are in FFICEncoding */
+	static uint8 KeyframeTypeToIndex(EFICKeyframeType Type);
+	static EFICKeyframeType IndexToKeyframeType(uint8 Index);
+	// End Encoding Helpers
+};
@@ -0,0 +1,44 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+class AFICScene;
+
+/**
+ * Scene interchange file, used to move scenes between save games.
+ *
+ * Layout: magic, version, scene name and settings, scene object count,
+ * then per scene object its class path, its size prefixed SaveGame properties (without keyframes)
+ * and its keyframes in the format of FFICSceneArchive.
+ * The file gets streamed from and to disk, so only the scene itself has to fit into memory.
+ */
+class FICSITCAM_API FFICSceneFile {
+public:
+	static constexpr uint32 Magic = 0x58434946; // "FICX"
+
+	enum EVersion : uint32 {
+		VERSION_INITIAL = 1,
+
+		VERSION_LATEST = VERSION_INITIAL,
+	};
+
+	/** Directory scene files get exported to and imported from, the FicsIt-Cam save directory */
+	static FString GetSceneFileDirectory();
+	/**
+	 * Resolves the given path relative to the scene file directory to an absolute path and adds the default extension if the path has none.
+	 * Returns false with a error if the path is absolute or leaves the scene file directory.
+	 */
+	static bool ResolvePath(const FString& InPath, FString& OutPath, FString& OutError);
+	
+	static bool Export(AFICScene* Scene, const FString& Path, FString& OutError);
+	/**
+	 * Creates a new scene from the given file, uses the scene name stored in the file if no name is given.
+	 * Returns nullptr and sets the error if the file is not readable.
+	 */
+	static AFICScene* Import(UObject* WorldContext, const FString& Path, const FString& SceneName, FString& OutError);
+
+	/**
+	 * Returns the scene name stored in the given file without reading the rest of the file.
+	 */
+	static bool ReadSceneName(const FString& Path, FString& OutSceneName);
+};
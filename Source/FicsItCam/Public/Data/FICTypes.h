@@ -1,10 +1,8 @@
 #pragma once
 
+#include "FICMathTypes.h"
 #include "FICTypes.generated.h"
 
-typedef int64 FICFrame;
-typedef float FICFrameFloat;
-
 struct FFICFrameRangeIterator {
 	FICFrame Frame;
 
@@ -114,8 +112,6 @@ struct TStructOpsTypeTraits<FFICFrameRange> : TStructOpsTypeTraitsBase2<FFICFram
 	};
 };
 
-typedef float FICValue;
-
 struct FFICValueRange {
 	FICValue Begin;
 	FICValue End;
@@ -39,6 +39,10 @@ public:
 	FFICFloatAttribute FocusDistance;
 
 	FFICGroupAttribute LensSettings;
+
+	/** If set, the camera gets captured into its own image sequence when rendering the scene with multi camera render enabled */
+	UPROPERTY(SaveGame)
+	bool bRenderOutput = false;
 	
 	UPROPERTY()
 	UFICEditorContext* EditorContext = nullptr;
@@ -0,0 +1,49 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Bounding volume hierarchy over the segments of a camera path, used for ray picking.
+ * Segments are split by their index along the path, as consecutive segments are spatially close
+ * this keeps the hierarchy tight and allows to refit only the nodes covering changed frames.
+ */
+class FFICCameraPathBVH {
+public:
+	/**
+	 * Rebuilds the hierarchy for the given path points.
+	 */
+	void Build(const TArray<FVector>& Points);
+
+	/**
+	 * Updates the bounds of all nodes containing the points between the given indices (inclusive).
+	 * The amount of points has to be the same as when the hierarchy got built.
+	 */
+	void Refit(const TArray<FVector>& Points, int32 FirstPoint, int32 LastPoint);
+
+	/**
+	 * Finds the segment closest to the origin of the ray passing within the given radius.
+	 * OutSegment is the index of the first point of the segment,
+	 * OutAlpha the position on the segment closest to the ray (0 at the first point, 1 at the second point).
+	 */
+	bool Raycast(const TArray<FVector>& Points, const FRay& Ray, float Radius, int32& OutSegment, float& OutAlpha, float& OutDistance) const;
+
+	int32 GetNumPoints() const { return NumPoints; }
+
+private:
+	static constexpr int32 MaxLeafSegments = 4;
+	
+	struct FNode {
+		FBox Bounds;
+		int32 SegmentBegin;
+		int32 SegmentEnd;
+		/** Index of the second child node, the first child directly follows its parent. INDEX_NONE for leaves */
+		int32 SecondChild = INDEX_NONE;
+	};
+
+	TArray<FNode> Nodes;
+	int32 NumPoints = 0;
+
+	int32 GetNumSegments() const { return FMath::Max(NumPoints - 1, NumPoints > 0 ? 1 : 0); }
+	static FBox GetSegmentBounds(const TArray<FVector>& Points, int32 SegmentBegin, int32 SegmentEnd);
+	int32 BuildNode(const TArray<FVector>& Points, int32 SegmentBegin, int32 SegmentEnd);
+};
@@ -143,7 +143,8 @@ public:
 		Attribute.AddKeyframe(Time);
 		typename AttribType::KeyframeType& KF = *Attribute.GetKeyframe(Time);
 		KF.Value = CurrentValue;
-		Attribute.RecalculateAllKeyframes();
+		Attribute.MarkKeyframeDirty(Time);
+		Attribute.RecalculateDirtyKeyframes();
 		Attribute.UnlockUpdateEvent();
 	}
 	
@@ -2,6 +2,7 @@
 
 #include "Editor/FICEditorContext.h"
 #include "BaseGizmos/TransformGizmo.h"
+#include "Editor/Data/FICCameraPathBVH.h"
 #include "Editor/ITF/FICSelectionInteraction.h"
 #include "FICEditorCameraActor.generated.h"
 
@@ -17,6 +18,8 @@ public:
 	TArray<FVector> FramePoints;
 	TSet<int64> KeyframePoints;
 	int64 Hovered = TNumericLimits<int64>::Min();
+	/** Hierarchy over the segments between the frame points, kept up to date by UpdateFramePoints */
+	FFICCameraPathBVH PathBVH;
 
 	UFICEditorCameraPathComponent();
 	
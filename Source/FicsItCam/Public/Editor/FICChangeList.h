@@ -34,6 +34,17 @@ struct FFICChange {
 	virtual FName ChangeType() = 0;
 	virtual bool IsStackable(TSharedRef<FFICChange> InChange) { return false; }
 	virtual void Stack(TSharedRef<FFICChange> InChange) {}
+
+	/**
+	 * Called by the change list right before the change gets undone, state that is captured lazily has to be captured here
+	 * so the change list can account for its memory.
+	 */
+	virtual void PrepareUndo() {}
+
+	/**
+	 * Returns the approximate amount of memory used by this change in bytes.
+	 */
+	virtual SIZE_T GetAllocatedSize() const { return sizeof(FFICChange); }
 };
 
 struct FFICChange_ActiveFrame : public FFICChange {
@@ -46,6 +57,7 @@ struct FFICChange_ActiveFrame : public FFICChange {
 	virtual void RedoChange() override;
 	virtual void UndoChange() override;
 	virtual FName ChangeType() override { return FName(TEXT("ActiveFrame")); }
+	virtual SIZE_T GetAllocatedSize() const override { return sizeof(FFICChange_ActiveFrame); }
 };
 
 struct FFICChangeSource {
@@ -66,6 +78,8 @@ struct FFICChange_Attribute : public FFICChange {
 	TSharedRef<FFICAttribute> FromAttribute;
 	TSharedRef<FFICAttribute> ToAttribute;
 	FFICChangeSource ChangeSource;
+	/** True if deltas got stacked onto this change, the resulting state is then captured when the change gets undone */
+	bool bCaptureToOnUndo = false;
 
 	FFICChange_Attribute(FFICAttribute* InAttribute, TSharedRef<FFICAttribute> InFromAttribute, FFICChangeSource ChangeSource = FFICChangeSource()) : Attribute(InAttribute), FromAttribute(InFromAttribute), ToAttribute(Attribute->Get()), ChangeSource(ChangeSource) {}
 
@@ -74,23 +88,68 @@ struct FFICChange_Attribute : public FFICChange {
 	}
 
 	virtual void UndoChange() override {
+		PrepareUndo();
 		Attribute->Set(FromAttribute);
 	}
 
+	virtual void PrepareUndo() override {
+		if (bCaptureToOnUndo) {
+			ToAttribute = Attribute->Get();
+			bCaptureToOnUndo = false;
+		}
+	}
+
 	virtual FName ChangeType() override {
 		return FName(TEXT("Attribute"));
 	}
 
-	virtual bool IsStackable(TSharedRef<FFICChange> InChange) override {
-		if (InChange->ChangeType() == ChangeType() && ChangeSource.IsValid()) {
-			return ChangeSource == StaticCastSharedRef<FFICChange_Attribute>(InChange)->ChangeSource;
-		}
-		return false;
+	virtual bool IsStackable(TSharedRef<FFICChange> InChange) override;
+	virtual void Stack(TSharedRef<FFICChange> InChange) override;
+	
+	virtual SIZE_T GetAllocatedSize() const override {
+		return sizeof(FFICChange_Attribute) + FromAttribute->GetAllocatedSize() + ToAttribute->GetAllocatedSize();
 	}
+};
+
+struct FFICKeyframeState {
+	bool bExists = false;
+	FICValue Value = 0;
+	FFICValueTimeFloat InControl;
+	FFICValueTimeFloat OutControl;
+	EFICKeyframeType Type = FIC_KF_NONE;
 
-	virtual void Stack(TSharedRef<FFICChange> InChange) override {
-		ToAttribute = StaticCastSharedRef<FFICChange_Attribute>(InChange)->ToAttribute;
+	static FFICKeyframeState Capture(FFICAttribute* Attribute, FICFrame Frame);
+	void Restore(FFICAttribute* Attribute, FICFrame Frame) const;
+};
+
+/**
+ * Attribute change that only stores the state of the keyframes at the given frames and of their neighbours
+ * (as their controls depend on the changed keyframes) for every keyframe holding child attribute.
+ * The states before the change get captured on construction, the states after the change with CaptureAfter.
+ */
+struct FFICChange_AttributeDelta : public FFICChange {
+	FFICAttribute* Attribute;
+	TMap<FFICAttribute*, TMap<FICFrame, FFICKeyframeState>> FromKeyframes;
+	TMap<FFICAttribute*, TMap<FICFrame, FFICKeyframeState>> ToKeyframes;
+	FFICChangeSource ChangeSource;
+
+	FFICChange_AttributeDelta(FFICAttribute* InAttribute, const TArray<FICFrame>& InFrames, FFICChangeSource ChangeSource = FFICChangeSource());
+
+	void CaptureAfter();
+	
+	virtual void RedoChange() override;
+	virtual void UndoChange() override;
+
+	virtual FName ChangeType() override {
+		return FName(TEXT("AttributeDelta"));
 	}
+
+	virtual bool IsStackable(TSharedRef<FFICChange> InChange) override;
+	virtual void Stack(TSharedRef<FFICChange> InChange) override;
+	virtual SIZE_T GetAllocatedSize() const override;
+
+private:
+	static void ApplyKeyframes(const TMap<FFICAttribute*, TMap<FICFrame, FFICKeyframeState>>& InKeyframes);
 };
 
 struct FFICChange_AddSceneObject : public FFICChange {
@@ -107,6 +166,10 @@ struct FFICChange_AddSceneObject : public FFICChange {
 	virtual FName ChangeType() override {
 		return FName(TEXT("AddSceneObject"));
 	}
+
+	virtual SIZE_T GetAllocatedSize() const override {
+		return sizeof(FFICChange_AddSceneObject) + SceneObjectName.GetAllocatedSize() + (Snapshot ? Snapshot->GetAllocatedSize() : 0);
+	}
 };
 
 struct FFICChange_RemoveSceneObject : public FFICChange {
@@ -124,6 +187,10 @@ struct FFICChange_RemoveSceneObject : public FFICChange {
 	virtual FName ChangeType() override {
 		return FName(TEXT("RemoveSceneObject"));
 	}
+
+	virtual SIZE_T GetAllocatedSize() const override {
+		return sizeof(FFICChange_RemoveSceneObject) + SceneObjectName.GetAllocatedSize() + (Snapshot ? Snapshot->GetAllocatedSize() : 0);
+	}
 };
 
 struct FFICChange_Group : public FFICChange {
@@ -137,10 +204,20 @@ struct FFICChange_Group : public FFICChange {
 		for (TSharedRef<FFICChange> Change : Changes) Change->UndoChange();
 	}
 
+	virtual void PrepareUndo() override {
+		for (TSharedRef<FFICChange> Change : Changes) Change->PrepareUndo();
+	}
+
 	virtual FName ChangeType() override {
 		return FName(TEXT("Group"));
 	}
 
+	virtual SIZE_T GetAllocatedSize() const override {
+		SIZE_T Size = sizeof(FFICChange_Group) + Changes.GetAllocatedSize();
+		for (const TSharedRef<FFICChange>& Change : Changes) Size += Change->GetAllocatedSize();
+		return Size;
+	}
+
 	void PushChange(TSharedRef<FFICChange> InChange) {
 		Changes.Add(InChange);
 	}
@@ -149,13 +226,27 @@ struct FFICChange_Group : public FFICChange {
 class FFICChangeList {
 private:
 	TArray<TSharedRef<FFICChange>> Changes;
+	TArray<SIZE_T> ChangeSizes;
 	int ChangeIndex = -1;
 
-	int MaxChanges = 50;
+	/** Amount of bytes the history may use, the oldest changes get dropped if it is exceeded. The newest change is always kept. */
+	SIZE_T MemoryBudget = 64 * 1024 * 1024;
+	SIZE_T MemoryUsage = 0;
 	
 public:
+	~FFICChangeList();
+	
 	void PushChange(TSharedRef<FFICChange> InChange);
 	TSharedPtr<FFICChange> PushChange();
 	TSharedPtr<FFICChange> PopChange();
 	TSharedPtr<FFICChange> PeakChange();
+
+	int Num() const { return Changes.Num(); }
+	SIZE_T GetMemoryUsage() const { return MemoryUsage; }
+	SIZE_T GetMemoryBudget() const { return MemoryBudget; }
+	void SetMemoryBudget(SIZE_T InMemoryBudget);
+
+private:
+	void UpdateChangeSize(int32 Index);
+	void EnforceMemoryBudget();
 };
@@ -30,6 +30,7 @@ enum EFICAnimPlayerState {
 DECLARE_MULTICAST_DELEGATE(FFICSceneObjectsChanged)
 DECLARE_MULTICAST_DELEGATE(FFICCurrentFrameChanged)
 DECLARE_MULTICAST_DELEGATE(FFICOverlayWidgetsChanged)
+DECLARE_MULTICAST_DELEGATE_OneParam(FFICAttributesUpdated, const TSet<FFICAttribute*>&)
 
 UCLASS()
 class UFICEditorContext : public UObject, public FTickableGameObject {
@@ -47,8 +48,18 @@ private:
 
 	TSharedPtr<FFICEditorAttributeGroupDynamic> AllAttributes;
 	TMap<UObject*, TSharedRef<FFICEditorAttributeBase>> EditorAttributes;
-	TMap<UObject*, FDelegateHandle> DataAttributeOnUpdateDelegateHandles;
+	TMap<UObject*, TArray<TPair<FFICAttribute*, FDelegateHandle>>> DataAttributeOnUpdateDelegateHandles;
 	TMap<FFICAttribute*, TSharedRef<FFICEditorAttributeBase>> EditorAttributeMap;
+	TMap<FFICAttribute*, FFICAttribute*> AttributeParents;
+
+	/** Keyframe holding attributes that changed since the last flush */
+	TSet<FFICAttribute*> PendingUpdatedAttributes;
+	/** Subset of the updated attributes whose editor attribute still has to load the new value */
+	TSet<FFICAttribute*> PendingValueUpdates;
+
+	/** Scene objects whose editor attributes did not load the current frame yet */
+	TSet<UObject*> StaleSceneObjects;
+	int32 StaleSceneObjectRefreshesPerTick = 16;
 
 	EFICAnimPlayerState AnimPlayerState = FIC_PLAY_PAUSED;
 	float AnimPlayerDelta = 0.0f;
@@ -64,6 +75,22 @@ private:
 
 	bool bBlockValueUpdate = false;
 	void* AutoKeyframeChangeRef = nullptr;
+	FFICChangeSource LastAutoKeyframeSource;
+	int32 AutoKeyframeDeltas = 0;
+	/** Amount of auto keyframe changes stored as delta until a full snapshot of the attribute gets stored again */
+	int32 AutoKeyframeCheckpointInterval = 25;
+
+	int32 EditBatchDepth = 0;
+	TArray<UObject*> PendingEditBatchObjects;
+
+	void OnSceneObjectValueChanged(UObject* SceneObject);
+
+	/**
+	 * Returns true if the editor attributes of the scene object should be updated directly on frame change,
+	 * because it is selected, visible in the viewport or (going to be) active.
+	 */
+	bool IsSceneObjectRelevant(UObject* SceneObject);
+	void RefreshSceneObjects(const TArray<UObject*>& SceneObjects);
 
 	FFICActiveSceneObjectManager ActiveSceneObjectManager;
 	
@@ -80,6 +107,12 @@ public:
 	FFICSceneObjectsChanged OnSceneObjectSelectionChanged;
 	FFICCurrentFrameChanged OnCurrentFrameChanged;
 	FFICOverlayWidgetsChanged OnOverlayWidgetsChanged;
+
+	/**
+	 * Called once per tick with all attributes that changed since the last tick,
+	 * the set contains the changed attributes that hold keyframes and all of their parent attributes.
+	 */
+	FFICAttributesUpdated OnAttributesUpdated;
 		
 	UFICEditorContext();
 
@@ -154,6 +187,30 @@ public:
 		AutoKeyframeChangeRef = Ref;
 	}
 
+	/**
+	 * While a edit batch is open, value changes of scene objects only get collected.
+	 * When the last batch ends, every changed scene object gets updated and auto keyframed only once.
+	 * Use FFICEditBatchScope instead of calling these directly.
+	 */
+	void BeginEditBatch();
+	void EndEditBatch();
+
+	/**
+	 * Updates the editor values of all attributes that changed since the last flush and notifies OnAttributesUpdated.
+	 * Gets called every tick, call it directly if updated editor values are needed immediately.
+	 */
+	void FlushAttributeUpdates();
+
+	/**
+	 * Loads the current frame into the editor attributes of the given scene object if it got skipped on frame change.
+	 */
+	void EnsureSceneObjectUpToDate(UObject* SceneObject);
+
+	/**
+	 * Returns true if the given scene object is active at the current frame.
+	 */
+	bool IsSceneObjectActive(UObject* SceneObject);
+
 	/**
 	 * Called after the Context Object got created.
 	 * Used to load a scene into the editor, create the editor attributes, load the scene objects etc.
@@ -175,3 +232,10 @@ public:
 	 */
 	void UpdateCharacterValues();
 };
+
+struct FFICEditBatchScope {
+	UFICEditorContext* Context;
+
+	FFICEditBatchScope(UFICEditorContext* InContext) : Context(InContext) { Context->BeginEditBatch(); }
+	~FFICEditBatchScope() { Context->EndEditBatch(); }
+};
@@ -31,6 +31,9 @@ private:
 	bool bForceResolution = false;
 	UPROPERTY(SaveGame)
 	bool bShowCameraPath = true;
+	/** Memory budget of the undo history in MB */
+	UPROPERTY(SaveGame)
+	int32 UndoHistoryBudgetMB = 64;
 	
 	UPROPERTY()
 	UFICEditorContext* ActiveEditorContext = nullptr;
@@ -50,8 +53,6 @@ private:
 	UPROPERTY()
 	UFICToolsContextRenderComponent* PDIRenderComponent;
 	UPROPERTY()
-	ULineBatchComponent* LineBatchComponent;
-	UPROPERTY()
 	UFICSelectionInteraction* SelectionInteraction;
 	UPROPERTY()
 	UFICTransformInteraction* TransformInteraction;
@@ -58,5 +58,9 @@ public:
 	virtual void OnEndHover() override;
 	// End IHoverBehaviourTarget
 
-	bool HitCameraPath(const FRay& InRay, UFICCamera*& OutCamera, int32& OutFrame, float& OutDistance);
+	/**
+	 * Finds the camera path segment closest to the ray origin passing near the ray.
+	 * OutFrame is the frame closest to the hit, OptOutSubFrame the interpolated frame at the hit.
+	 */
+	bool HitCameraPath(const FRay& InRay, UFICCamera*& OutCamera, int32& OutFrame, float& OutDistance, FICFrameFloat* OptOutSubFrame = nullptr);
 };
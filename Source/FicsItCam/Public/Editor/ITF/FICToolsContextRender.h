@@ -8,7 +8,6 @@
 class FRuntimeToolsFrameworkRenderImpl : public IToolsContextRenderAPI {
 public:
 	UFICToolsContextRenderComponent* RenderComponent = nullptr;
-	ULineBatchComponent* LineBatchComponent = nullptr;
 	TSharedPtr<FPrimitiveDrawInterface> PDI;
 	const FSceneView* SceneView;
 	FViewCameraState ViewCameraState;
@@ -16,10 +15,6 @@ public:
 	FRuntimeToolsFrameworkRenderImpl(UFICToolsContextRenderComponent* RenderComponentIn, const FSceneView* ViewIn, FViewCameraState CameraState) : RenderComponent(RenderComponentIn), SceneView(ViewIn), ViewCameraState(CameraState) {
 		PDI = RenderComponentIn->GetPDIForView(ViewIn);
 	}
-	
-	FRuntimeToolsFrameworkRenderImpl(ULineBatchComponent* LineBatchComponentIn, const FSceneView* ViewIn, FViewCameraState CameraState) : LineBatchComponent(LineBatchComponentIn), SceneView(ViewIn), ViewCameraState(CameraState) {
-		PDI = UFICToolsContextRenderComponent::GetPDIForView(ViewIn, LineBatchComponent);
-	}
 
 	virtual FPrimitiveDrawInterface* GetPrimitiveDrawInterface() override {
 		return PDI.Get();
@@ -18,8 +18,9 @@ class FPrimitiveDrawInterface;
  * (in the UE Editor, those functions can be passed an Editor PDI that can draw immediately,
  *  but this is not possible at Runtime, so we use this accumulate-and-draw workaround)
  *
- * TODO: lines and points could be drawn via Line/Point Components, which would allow them
- * to be batched, providing much better performance.
+ * The accumulated geometry is split into chunks in draw order. SubmitGeometry() only sends
+ * chunks that differ from the last submitted frame to the SceneProxy, which keeps its copy of
+ * the geometry, so geometry that doesn't change between frames is not copied again.
  */
 UCLASS()
 class UFICToolsContextRenderComponent : public UPrimitiveComponent {
@@ -51,7 +52,6 @@ public:
 
 	/** @return a new FPrimitiveDrawInterface implementation allocated for the given FSceneView. See .cpp for details. */
 	TSharedPtr<FPrimitiveDrawInterface> GetPDIForView(const FSceneView* InView);
-	static TSharedPtr<FPrimitiveDrawInterface> GetPDIForView(const FSceneView* InView, ULineBatchComponent* LineBatchComponent);
 
 	// mirrors FPrimitiveDrawInterface::DrawLine()
 	virtual void DrawLine(
@@ -72,6 +72,15 @@ public:
 		uint8 DepthPriorityGroup
 	);
 
+	/**
+	 * Hands the lines and points drawn since the last call over to the SceneProxy.
+	 * Only chunks that changed since the last call get sent to the rendering thread.
+	 */
+	void SubmitGeometry();
+
+	// amount of lines or points per chunk that gets compared and sent as a whole
+	static constexpr int32 GeometryChunkSize = 256;
+
 
 protected:
 
@@ -81,12 +90,11 @@ protected:
 	// set of points created by DrawPoint calls
 	TArray<FPDIPoint> CurrentPoints;
 
-	// protects CurrentLines and CurrentPoints
-	FCriticalSection GeometryLock;
-
-	// returns a lambda that will be passed to SceneProxy, which will then allow it to
-	// steal values of CurrentLines and CurrentPoints
-	TUniqueFunction<void(TArray<FPDILine>&, TArray<FPDIPoint>&)> MakeGetCurrentGeometryQueryFunc();
+	// hashes of the chunks the SceneProxy currently has
+	TArray<uint32> SubmittedLineChunkHashes;
+	TArray<uint32> SubmittedPointChunkHashes;
+	int32 LastSubmittedLineChunks = 0;
+	int32 LastSubmittedPointChunks = 0;
 
 	//~ Begin UPrimitiveComponent Interface.
 	virtual FPrimitiveSceneProxy* CreateSceneProxy() override;
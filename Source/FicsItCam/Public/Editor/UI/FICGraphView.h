@@ -147,7 +147,6 @@ private:
 	FFICValueRangeChanged OnValueRangeChanged;
 
 	TArray<TSharedRef<FFICEditorAttributeBase>> Attributes;
-	TMap<TSharedRef<FFICEditorAttributeBase>, FDelegateHandle> DelegateHandles;
 
 	TSet<TPair<FFICAttribute*, FICFrame>> SelectedKeyframes;
 	TSet<TPair<FFICAttribute*, FICFrame>> SelectedWithBox;
@@ -189,6 +188,7 @@ public:
 
 	void SetAttributes(const TArray<TSharedRef<FFICEditorAttributeBase>>& InAttributes);
 	void Update();
+	void OnAttributesUpdated(const TSet<FFICAttribute*>& UpdatedAttributes);
 	void FitAll();
 
 	void SetValueRange(const FFICValueRange& InRange) {
@@ -130,7 +130,6 @@ private:
 	TSlotlessChildren<SFICSequencerRowAttributeKeyframe> Children;
 
 	TSharedPtr<FFICEditorAttributeBase> Attribute;
-	FDelegateHandle DelegateHandle;
 
 public:
 	SFICSequencerRowAttribute();
@@ -144,6 +143,7 @@ public:
 	// End SWidget
 
 	void UpdateKeyframes();
+	void OnAttributesUpdated(const TSet<FFICAttribute*>& UpdatedAttributes);
 
 	FFICAttribute* GetAttribute() const;
 		
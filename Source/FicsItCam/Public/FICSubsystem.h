@@ -4,9 +4,12 @@
 #include "Subsystem/ModSubsystem.h"
 #include "FGSaveInterface.h"
 #include "IImageWrapper.h"
+#include "Runtime/FICImageProcessing.h"
 #include "FICSubsystem.generated.h"
 
 class UFICRuntimeProcess;
+class UFICRuntimeProcessTimelapseCamera;
+class UFICRuntimeProcessCameraFeed;
 class AFICScene;
 class AFICTimelapseCamera;
 class UFICEditorContext;
@@ -20,15 +23,47 @@ struct FFICRenderTarget {
 	virtual FRenderTarget* GetRenderTarget() = 0;
 };
 
+/**
+ * Keeps the readbacks of finished render requests, so following requests of the same size reuse their staging textures
+ * instead of allocating new ones for every frame.
+ */
+class FFICReadbackPool {
+public:
+	FFICReadbackPool(FName InName) : Name(InName) {}
+	
+	TSharedRef<FRHIGPUTextureReadback> Acquire();
+	/** Returns a readback that got read and unlocked to the pool */
+	void Release(TSharedPtr<FRHIGPUTextureReadback> Readback);
+
+private:
+	static constexpr int32 MaxFreeReadbacks = 8;
+	
+	FName Name;
+	TArray<TSharedRef<FRHIGPUTextureReadback>> FreeReadbacks;
+};
+
 struct FFICRenderRequest {
 	FRenderCommandFence RenderFence;
 	
-	FRHIGPUTextureReadback Readback;
+	TSharedRef<FRHIGPUTextureReadback> Readback;
+	/** Only set if the settings request a proxy */
+	TSharedPtr<FRHIGPUTextureReadback> ProxyReadback;
 
-	FString Path;
+	TArray<FFICImageOutput> Outputs;
 	TSharedRef<FFICRenderTarget> RenderTarget;
+	FFICImageOutputSettings Settings;
 
-	FFICRenderRequest(TSharedRef<FFICRenderTarget> RenderTarget, FString Path, FRHIGPUTextureReadback Readback) : RenderTarget(RenderTarget), Path(Path), Readback(Readback) {}
+	// Set by the render thread, valid once the fence is complete
+	FIntPoint SourceSize = FIntPoint::ZeroValue;
+	FIntPoint ReadbackSize = FIntPoint::ZeroValue;
+	FIntPoint ProxyReadbackSize = FIntPoint::ZeroValue;
+	bool bReadbackBGRA = false;
+	FTexture2DRHIRef ConvertedTexture;
+	FTexture2DRHIRef ProxyTexture;
+
+	FFICRenderRequest(TSharedRef<FFICRenderTarget> RenderTarget, const TArray<FFICImageOutput>& Outputs, const FFICImageOutputSettings& Settings, TSharedRef<FRHIGPUTextureReadback> Readback, TSharedPtr<FRHIGPUTextureReadback> ProxyReadback) : Readback(Readback), ProxyReadback(ProxyReadback), Outputs(Outputs), RenderTarget(RenderTarget), Settings(Settings) {}
+
+	bool IsReady() const;
 };
 
 struct FFICRenderTarget_Raw : public FFICRenderTarget {
@@ -39,9 +74,15 @@ struct FFICRenderTarget_Raw : public FFICRenderTarget {
 	virtual FRenderTarget* GetRenderTarget() override { return RenderTarget; }
 };
 
+struct FFICImageData {
+	TArray64<uint8> Pixels;
+	FIntPoint Size = FIntPoint::ZeroValue;
+	bool bBGRA = false;
+};
+
 class FFICAsyncImageCompressAndSave : public FNonAbandonableTask{
 public:
-	FFICAsyncImageCompressAndSave(TSharedPtr<IImageWrapper> Image, FString Path);
+	FFICAsyncImageCompressAndSave(FFICImageData&& Image, FFICImageData&& Proxy, const FFICImageOutputSettings& Settings, TSharedPtr<IImageWrapper> ImageWrapper, TSharedPtr<IImageWrapper> ProxyWrapper, TArray<FFICImageOutput> Outputs);
 	~FFICAsyncImageCompressAndSave();
 
 	// Required by UE4!
@@ -50,18 +91,27 @@ public:
 	}
 
 protected:
-	TSharedPtr<IImageWrapper> Image;
-	FString Path = "";
+	FFICImageData Image;
+	FFICImageData Proxy;
+	FFICImageOutputSettings Settings;
+	TSharedPtr<IImageWrapper> ImageWrapper;
+	TSharedPtr<IImageWrapper> ProxyWrapper;
+	TArray<FFICImageOutput> Outputs;
+
+	/** Encodes the image once and writes it to all given paths */
+	void SaveImage(const FFICImageData& InImage, TSharedPtr<IImageWrapper> InWrapper, const TArray<FString>& InPaths);
 
 public:
 	void DoWork();
 };
 
-UCLASS()
+UCLASS(Config=FicsItCam)
 class AFICSubsystem : public AModSubsystem, public IFGSaveInterface {
 	GENERATED_BODY()
 private:
 	TQueue<TSharedPtr<FFICRenderRequest>> RenderRequestQueue;
+	FFICReadbackPool ReadbackPool = FFICReadbackPool(TEXT("FICSubsystem Texture Readback"));
+	FFICReadbackPool ProxyReadbackPool = FFICReadbackPool(TEXT("FICSubsystem Proxy Readback"));
 
 	UPROPERTY(SaveGame)
 	TMap<FString, UFICRuntimeProcess*> RuntimeProcesses;
@@ -69,6 +119,9 @@ private:
 	TSet<UFICRuntimeProcess*> PersistentActiveRuntimeProcesses;
 	UPROPERTY()
 	TSet<UFICRuntimeProcess*> ActiveRuntimeProcesses;
+
+	UPROPERTY()
+	TArray<UFICRuntimeProcessTimelapseCamera*> PendingTimelapseCaptures;
 	
 	UPROPERTY()
 	AFICRuntimeProcessorCharacter* RuntimeProcessorCharacter = nullptr;
@@ -76,8 +129,33 @@ private:
 	ACharacter* OriginalPlayerCharacter = nullptr;
 
 	TMap<TSubclassOf<UFICCommand>, TMap<FString, UFICCommand*>> Commands;
+
+	void TickTimelapseCaptures();
+
+	/** Camera feeds due for a capture this tick, collected while ticking the runtime processes */
+	UPROPERTY()
+	TArray<UFICRuntimeProcessCameraFeed*> DueFeedCaptures;
+
+	void TickFeedCaptures();
+
+	/** Scenes by their name, maintained by the scenes themselves */
+	TMap<FString, AFICScene*> SceneIndex;
+
+	void RebuildSceneIndex();
+	void RemoveSceneFromIndex(AFICScene* InScene, const FString& InSceneName);
+
+	/** Incremented whenever resolved references to scenes, scene objects or runtime processes might have become stale */
+	uint32 ReferenceGeneration = 1;
 	
 public:
+	/** Maximum amount of timelapse captures per tick, further captures get delayed to the following ticks */
+	UPROPERTY(Config)
+	int32 MaxTimelapseCapturesPerTick = 2;
+
+	/** Maximum amount of camera feed captures per tick across all open camera feeds */
+	UPROPERTY(Config)
+	int32 MaxFeedCapturesPerTick = 2;
+	
 	UFUNCTION(BlueprintCallable, Category="FicsIt-Cam", meta=(WorldContext = "WorldContextObject"))
 	static AFICSubsystem* GetFICSubsystem(UObject* WorldContext);
 	
@@ -116,9 +194,42 @@ public:
 
 	AFICRuntimeProcessorCharacter* GetRuntimeProcessorCharacter() { return RuntimeProcessorCharacter; }
 	
-	void SaveRenderTargetAsJPG(const FString& FilePath, TSharedRef<FFICRenderTarget> RenderTarget);
+	/**
+	 * Queues a capture of the given timelapse camera.
+	 * Captures are done in request order, limited by MaxTimelapseCapturesPerTick,
+	 * and pending timelapse cameras capturing the same image share a single capture.
+	 */
+	void RequestTimelapseCapture(UFICRuntimeProcessTimelapseCamera* InProcess);
+	void CancelTimelapseCapture(UFICRuntimeProcessTimelapseCamera* InProcess);
+
+	/**
+	 * Marks the given camera feed as due for a capture.
+	 * At the end of the tick the most overdue feeds get captured, limited by MaxFeedCapturesPerTick.
+	 */
+	void RequestFeedCapture(UFICRuntimeProcessCameraFeed* InProcess);
+	
+	/** Returns true if render requests are waiting for their readback */
+	bool HasPendingRenderRequests() const { return !RenderRequestQueue.IsEmpty(); }
+	
+	void SaveRenderTargetAsJPG(const FString& FilePath, TSharedRef<FFICRenderTarget> RenderTarget, const FFICImageOutputSettings& Settings = FFICImageOutputSettings());
+	/** Reads the render target back once and stores the image to all given outputs */
+	void SaveRenderTargetAsJPG(const TArray<FFICImageOutput>& Outputs, TSharedRef<FFICRenderTarget> RenderTarget, const FFICImageOutputSettings& Settings = FFICImageOutputSettings());
 
 	AFICScene* FindSceneByName(const FString& InSceneName);
+	
+	// Begin Scene Index
+	void RegisterScene(AFICScene* InScene);
+	void UnregisterScene(AFICScene* InScene);
+	void OnSceneRenamed(AFICScene* InScene, const FString& InOldSceneName);
+	// End Scene Index
+
+	uint32 GetReferenceGeneration() const { return ReferenceGeneration; }
+	/**
+	 * Has to be called when runtime processes, scenes or scene objects got added, removed or renamed.
+	 * Causes cached references (f.e. of FFICCameraReference) to be resolved again.
+	 */
+	void InvalidateReferences() { ++ReferenceGeneration; }
+	
 	UFICRuntimeProcess* FindRuntimeProcess(const FString& InKey);
 	FString FindRuntimeProcessKey(UFICRuntimeProcess* InProcess);
 };
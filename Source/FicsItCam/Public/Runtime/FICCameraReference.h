@@ -6,6 +6,7 @@
 class UFICRuntimeProcessPlayScene;
 class UFICCamera;
 class AFICScene;
+class AFICSubsystem;
 
 USTRUCT()
 struct FFICCameraSettingsSnapshot {
@@ -30,6 +31,14 @@ struct FFICCameraSettingsSnapshot {
 	float FocusDistance;
 
 	bool IsValid() { return !!Camera; }
+
+	bool Equals(const FFICCameraSettingsSnapshot& Other, float Tolerance = KINDA_SMALL_NUMBER) const {
+		return Location.Equals(Other.Location, Tolerance)
+			&& Rotation.Equals(Other.Rotation, Tolerance)
+			&& FMath::IsNearlyEqual(FOV, Other.FOV, Tolerance)
+			&& FMath::IsNearlyEqual(Aperture, Other.Aperture, Tolerance)
+			&& FMath::IsNearlyEqual(FocusDistance, Other.FocusDistance, Tolerance);
+	}
 };
 
 USTRUCT()
@@ -48,6 +57,19 @@ private:
 	UPROPERTY(SaveGame)
 	FString Camera;
 
+	/**
+	 * Objects the reference got resolved to, valid as long as the reference generation of the subsystem didn't change.
+	 */
+	struct FResolved {
+		uint32 Generation = 0;
+		TWeakObjectPtr<AFICSubsystem> Subsystem;
+		TWeakObjectPtr<AFICScene> Scene;
+		TWeakObjectPtr<UFICCamera> Camera;
+		TWeakObjectPtr<UFICRuntimeProcessPlayScene> PlayScene;
+	};
+	mutable FResolved Resolved;
+
+	const FResolved& Resolve(UObject* WorldContext) const;
 	UFICRuntimeProcessPlayScene* GetCurrentScenePlay(UObject* WorldContext) const;
 
 public:
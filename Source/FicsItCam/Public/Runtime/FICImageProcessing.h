@@ -0,0 +1,111 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "RHI.h"
+#include "RHICommandList.h"
+#include "Async/TaskGraphInterfaces.h"
+
+enum class EFICImageFormat : uint8 {
+	RGBA,
+	BGRA,
+	YUV420,
+};
+
+class FFICImageChangeDetector;
+
+struct FFICImageOutputSettings {
+	/**
+	 * Stored images have a width of a multiple of this many pixels, so the rows of their readback are tightly packed.
+	 * Staging textures pad their rows to 256 bytes (D3D12), which would shear images of any other width.
+	 */
+	static constexpr int32 WidthAlignment = 64;
+	
+	/** Size of the stored image, zero keeps the size of the render target. The width gets rounded to the width alignment. */
+	FIntPoint Size = FIntPoint::ZeroValue;
+	EFICImageFormat Format = EFICImageFormat::RGBA;
+	/** Additionally stores a half-size copy of the image with a "_proxy" suffix */
+	bool bWriteProxy = false;
+
+	FIntPoint GetOutputSize(FIntPoint SourceSize) const;
+	FIntPoint GetProxySize(FIntPoint SourceSize) const;
+	/** Returns the given size with its width rounded to the nearest multiple of the width alignment */
+	static FIntPoint AlignSize(FIntPoint InSize);
+	/** Returns true if a render target of the given size should be resampled or swizzled before its readback */
+	bool NeedsConversion(FIntPoint SourceSize) const;
+};
+
+/** A file an image gets stored to, multiple outputs can share the readback and encoding of a single image */
+struct FFICImageOutput {
+	FString Path;
+	/** If set, images that barely differ from the previously stored image of this output are not written */
+	TSharedPtr<FFICImageChangeDetector> ChangeDetector;
+
+	FFICImageOutput() = default;
+	FFICImageOutput(const FString& Path, TSharedPtr<FFICImageChangeDetector> ChangeDetector = nullptr) : Path(Path), ChangeDetector(ChangeDetector) {}
+};
+
+class FFICImageProcessing {
+public:
+	/**
+	 * Returns true if the render thread is able to resample and convert render targets before their readback.
+	 * When using the null RHI all conversions are done by the CPU reference implementation instead.
+	 */
+	static bool SupportsGPUConversion();
+
+	/**
+	 * Draws the given source texture into a new texture of the given size and format using bilinear filtering.
+	 * Has to be called on the rendering thread. The returned texture is ready to be copied.
+	 */
+	static FTexture2DRHIRef ResampleOnGPU(FRHICommandListImmediate& RHICmdList, FRHITexture2D* Source, FIntPoint Size, EPixelFormat Format);
+
+	/**
+	 * Draws the given source texture stretched over the whole given target texture using bilinear filtering and the given blend state.
+	 * Has to be called on the rendering thread. The target is left as render target.
+	 */
+	static void DrawTexture(FRHICommandListImmediate& RHICmdList, FRHITexture2D* Source, FRHITexture2D* Target, FRHIBlendState* BlendState, FLinearColor BlendFactor = FLinearColor::White, ERenderTargetActions Actions = ERenderTargetActions::DontLoad_Store);
+
+	// Begin CPU Reference Implementation
+	static void Resample(const TArray64<uint8>& InPixels, FIntPoint InSize, TArray64<uint8>& OutPixels, FIntPoint OutSize);
+	static void SwizzleRedBlue(TArray64<uint8>& InOutPixels);
+	static void ConvertToYUV420(const TArray64<uint8>& InPixels, FIntPoint InSize, bool bBGRA, TArray64<uint8>& OutPlanes);
+	// End CPU Reference Implementation
+};
+
+/**
+ * Compares images by a small luminance thumbnail against the last image that got stored.
+ * Every decision is appended to a manifest file, skipped images are listed as repeat of the previous stored image.
+ */
+class FFICImageChangeDetector {
+public:
+	FFICImageChangeDetector(float Threshold, FString ManifestPath) : Threshold(Threshold), ManifestPath(ManifestPath) {}
+
+	/**
+	 * Runs the given decision on a background thread once all decisions queued before for any of the given detectors are done.
+	 * Keeps the images of every detector in capture order without blocking the game thread. Has to be called on the game thread.
+	 */
+	static void QueueDecision(const TArray<TSharedPtr<FFICImageChangeDetector>>& Detectors, TUniqueFunction<void()> Decision);
+
+	/**
+	 * Returns true if the image differs enough from the last stored image and should be stored at the given path.
+	 * Has to be called in capture order from a decision queued for this detector.
+	 */
+	bool ShouldStore(const TArray64<uint8>& Pixels, FIntPoint Size, bool bBGRA, const FString& Path);
+
+private:
+	static constexpr int32 SignatureSize = 32;
+	static constexpr int32 SamplesPerCell = 4;
+	
+	/** Mean absolute luminance difference (0-1) below which an image counts as unchanged */
+	float Threshold;
+	FString ManifestPath;
+	/** Opened with the first decision and kept open until the detector gets destroyed */
+	TUniquePtr<FArchive> Manifest;
+
+	TArray<uint8> PreviousSignature;
+	FString PreviousFile;
+
+	/** Last decision queued for this detector, only accessed on the game thread */
+	FGraphEventRef LastDecision;
+
+	static void ComputeSignature(const TArray64<uint8>& Pixels, FIntPoint Size, bool bBGRA, TArray<uint8>& OutSignature);
+};
@@ -27,8 +27,25 @@ public:
 	UPROPERTY(SaveGame)
 	bool bEverSaved = false;
 
+	/** Capture rate of new feeds if none is given */
+	static constexpr float DefaultCaptureRate = 30.0f;
+	
+	/**
+	 * Captures per second, zero or less captures every frame.
+	 * Feeds loaded from saves without a stored rate predate the throttling and keep capturing every frame.
+	 */
+	UPROPERTY(SaveGame)
+	float TargetCaptureRate = 0.0f;
+	/** Scale applied to the feed resolution for the captured image */
+	UPROPERTY(SaveGame)
+	float ResolutionScale = 1.0f;
+
+	float TimeSinceCapture = 0.0f;
+	float LastDeltaSeconds = 0.0f;
+
 	void SaveWindowSettings();
 	void LoadWindowSettings();
+	bool IsWindowVisible() const;
 	
 public:
 	// Begin IFGSaveInterface
@@ -41,4 +58,10 @@ public:
 	virtual void Stop(AFICRuntimeProcessorCharacter* InCharacter) override;
 	virtual bool IsPersistent() override { return true; }
 	// End UFICRuntimeProcess
+
+	/** Returns the amount of capture intervals passed since the last capture */
+	float GetCaptureLateness() const;
+	
+	/** Captures the camera into the feed, called by the subsystem once the feed got a share of the capture budget */
+	void Capture();
 };
\ No newline at end of file
@@ -62,7 +62,7 @@ public:
 		FTexture2DRHIRef ShaderResourceTextureRHI;
 
 		FRHIResourceCreateInfo CreateInfo;
-		RHICreateTargetableShaderResource2D( SizeX, SizeY, PF_R8G8B8A8, 1, TexCreate_Shared | TexCreate_Dynamic | TexCreate_DisableSRVCreation, TexCreate_RenderTargetable, false, CreateInfo, RenderTargetTextureRHI, ShaderResourceTextureRHI );
+		RHICreateTargetableShaderResource2D( SizeX, SizeY, PF_R8G8B8A8, 1, TexCreate_Shared | TexCreate_Dynamic, TexCreate_RenderTargetable, false, CreateInfo, RenderTargetTextureRHI, ShaderResourceTextureRHI );
 	}
 
 	virtual void InitRHI() override{}
@@ -80,6 +80,53 @@ private:
 	FCanvas* DebugCanvas;
 };
 
+/**
+ * Averages multiple samples of a frame into a half float buffer, which gets resolved into a 8-bit texture for the readback.
+ * Both textures are kept for the whole render, so samples don't allocate and the readback of a frame
+ * is already queued when the samples of the next frame get drawn.
+ */
+class FFICAccumulationTarget : public FRenderTarget, public FRenderResource, public FFICRenderTarget {
+public:
+	FFICAccumulationTarget(FIntPoint InSize) : Size(InSize) {
+		BeginInitResource(this);
+	}
+
+	~FFICAccumulationTarget() {
+		BeginReleaseResource(this);
+		FlushRenderingCommands();
+	}
+
+	/**
+	 * Adds the given sample with the given weight to the buffer, the first sample of a frame replaces the previous content.
+	 * Has to be called on the rendering thread.
+	 */
+	void AccumulateSample_RenderThread(FRHICommandListImmediate& RHICmdList, FRHITexture2D* Sample, float Weight, bool bFirstSample);
+
+	/**
+	 * Writes the accumulated samples into the render target texture, so it can be read back.
+	 * Has to be called on the rendering thread.
+	 */
+	void Resolve_RenderThread(FRHICommandListImmediate& RHICmdList);
+	
+	// Begin FRenderTarget
+	virtual FIntPoint GetSizeXY() const override { return Size; }
+	// End FRenderTarget
+
+	// Begin FRenderResource
+	virtual void InitDynamicRHI() override;
+	virtual void ReleaseDynamicRHI() override;
+	virtual FString GetFriendlyName() const override { return FString(TEXT("FFICAccumulationTarget")); }
+	// End FRenderResource
+	
+	// Begin FFICRenderTarget
+	virtual FRenderTarget* GetRenderTarget() override { return this; }
+	// End FFICRenderTarget
+
+private:
+	FIntPoint Size;
+	FTexture2DRHIRef AccumulationTexture;
+};
+
 UCLASS()
 class UFICRuntimeProcessRenderScene : public UFICRuntimeProcessPlayScene {
 	GENERATED_BODY()
@@ -87,10 +134,24 @@ public:
 	UPROPERTY()
 	AFICCaptureCamera* CaptureCamera = nullptr;
 
+	UPROPERTY()
+	TMap<UFICCamera*, AFICCaptureCamera*> OutputCaptureCameras;
+	/** Accumulation targets of the output cameras, so they get the same motion blur as the main output */
+	TMap<UFICCamera*, TSharedPtr<FFICAccumulationTarget>> OutputAccumulationTargets;
+
+	FString OutputDirectory;
+
 	TSharedPtr<FFICRendererViewport> DummyViewport = nullptr;
 
 	FICFrame FrameProgress = 0;
 
+	/** Amount of sub-frame samples averaged into every output frame, more than one results in motion blur */
+	int32 MotionBlurSamples = 1;
+	int32 SubFrameProgress = 0;
+	TSharedPtr<FFICAccumulationTarget> AccumulationTarget;
+
+	FFICImageOutputSettings OutputSettings;
+
 	float PrevMinUndilatedFrameTime = 0;
 	float PrevMaxUndilatedFrameTime = 0;
 
@@ -101,4 +162,14 @@ public:
 	// End UFICRuntimeProcess
 
 	void Frame();
+
+	/**
+	 * Adds the given sample to the given accumulation target and resolves the target after the last sample of a frame.
+	 */
+	void AccumulateSample(FFICAccumulationTarget* Target, FRenderTarget* Sample, bool bFirstSample, bool bLastSample);
+	
+	/**
+	 * Captures every output camera at the given (sub-frame) time, the images get stored with the last sample of a frame.
+	 */
+	void CaptureOutputCameras(FICFrameFloat Time, bool bFirstSample, bool bLastSample);
 };
\ No newline at end of file
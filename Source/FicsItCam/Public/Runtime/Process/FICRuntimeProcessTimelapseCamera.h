@@ -17,6 +17,14 @@ public:
 	UPROPERTY(SaveGame)
 	float SecondsPerFrame = 10.0f;
 
+	/** If set, frames that barely changed compared to the last stored frame are not stored but listed in the manifest */
+	UPROPERTY(SaveGame)
+	bool bSkipUnchangedFrames = false;
+
+	/** Mean luminance difference (0-1) a frame needs to have to the last stored frame to get stored */
+	UPROPERTY(SaveGame)
+	float ChangeThreshold = 0.01f;
+
 	UPROPERTY()
 	float Time = 0.0f;
 	UPROPERTY()
@@ -24,6 +32,10 @@ public:
 	UPROPERTY()
 	int CaptureIncrement;
 
+	FString OutputDirectory;
+	bool bCaptureRequested = false;
+	TSharedPtr<FFICImageChangeDetector> ChangeDetector;
+
 	// Begin IFGSaveInterface
 	virtual bool ShouldSave_Implementation() const override { return true; }
 	// End IFGSaveInterface
@@ -33,4 +45,18 @@ public:
 	virtual void Tick(AFICRuntimeProcessorCharacter* InCharacter, float DeltaSeconds) override;
 	virtual void Stop(AFICRuntimeProcessorCharacter* InCharacter) override;
 	// End UFICRuntimeProcess
+
+	/**
+	 * Captures the camera and stores the image as the next frame of this timelapse and of all the given timelapses.
+	 * Called by the subsystem's timelapse scheduler.
+	 */
+	void Capture(const TArray<UFICRuntimeProcessTimelapseCamera*>& SharedWith);
+
+	/**
+	 * Returns true if the given timelapse would capture the exact same image, so a single capture can be used for both.
+	 */
+	bool CanShareCapture(UFICRuntimeProcessTimelapseCamera* Other);
+
+	/** Returns the output the next frame of this timelapse gets stored to */
+	FFICImageOutput ConsumeCaptureOutput();
 };
@@ -0,0 +1,28 @@
+using UnrealBuildTool;
+using System.Collections.Generic;
+
+/**
+ * Builds FicsItCamBenchmark as standalone console program, f.e. "Engine/Build/BatchFiles/Build.bat FicsItCamBenchmark Win64 Development -Project=<FactoryGame.uproject>"
+ */
+[SupportedPlatforms(UnrealPlatformClass.Desktop)]
+public class FicsItCamBenchmarkTarget : TargetRules
+{
+	public FicsItCamBenchmarkTarget(TargetInfo Target) : base(Target)
+	{
+		Type = TargetType.Program;
+		LinkType = TargetLinkType.Monolithic;
+		LaunchModuleName = "FicsItCamBenchmark";
+
+		DefaultBuildSettings = BuildSettingsVersion.V2;
+
+		bBuildDeveloperTools = false;
+		bCompileAgainstEngine = false;
+		bCompileAgainstCoreUObject = false;
+		bCompileAgainstApplicationCore = false;
+		bCompileICU = false;
+		bUseLoggingInShipping = true;
+		bIsBuildingConsoleApplication = true;
+
+		EnablePlugins.Add("FicsItCam");
+	}
+}
@@ -0,0 +1,24 @@
+using UnrealBuildTool;
+using System.IO;
+
+/**
+ * Command line program benchmarking the keyframe math of FicsItCamMath without starting the game.
+ */
+public class FicsItCamBenchmark : ModuleRules
+{
+    public FicsItCamBenchmark(ReadOnlyTargetRules Target) : base(Target)
+    {
+        PCHUsage = PCHUsageMode.UseExplicitOrSharedPCHs;
+
+		PublicIncludePaths.Add(Path.Combine(EngineDirectory, "Source/Runtime/Launch/Public"));
+		PrivateIncludePaths.Add(Path.Combine(EngineDirectory, "Source/Runtime/Launch/Private"));
+
+		PrivateDependencyModuleNames.AddRange(new string[] {
+            "Core",
+            "Projects",
+            "FicsItCamMath"
+		});
+
+        OptimizeCode = CodeOptimization.Always;
+    }
+}
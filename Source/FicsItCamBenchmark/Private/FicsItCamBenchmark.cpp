@@ -0,0 +1,260 @@
+#include "RequiredProgramMainCPPInclude.h"
+
+#include "FICCurve.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogFicsItCamBenchmark, Log, All);
+
+IMPLEMENT_APPLICATION(FicsItCamBenchmark, "FicsItCamBenchmark");
+
+struct FFICBenchmarkSettings {
+	int32 Keys = 1000;
+	int32 Iterations = 20;
+	int32 Seed = 1337;
+	FString CSVPath;
+	/** Results of another build to compare against, f.e. of a unoptimized Debug build */
+	FString ComparePath;
+	/** Speedup the evaluation benchmarks need against the compared results */
+	float MinSpeedup = 1.0f;
+};
+
+struct FFICBenchmarkResult {
+	FString Name;
+	int64 Operations = 0;
+	TArray<double> Seconds;
+	/** Value computed by the benchmark (like the sum of all evaluated values), keeps the calls from getting optimized away and has to match in every build */
+	double Value = 0.0;
+
+	double GetMinNs() const { return FMath::Min(Seconds) * 1e9 / Operations; }
+	double GetMedianNs() const {
+		TArray<double> Sorted = Seconds;
+		Sorted.Sort();
+		return Sorted[Sorted.Num() / 2] * 1e9 / Operations;
+	}
+};
+
+static TArray<TPair<FICFrame, FFICCurveKey>> GenerateKeys(const FFICBenchmarkSettings& Settings) {
+	FRandomStream Random(Settings.Seed);
+	TArray<TPair<FICFrame, FFICCurveKey>> Keys;
+	Keys.Reserve(Settings.Keys);
+	FICFrame Frame = 0;
+	for (int32 i = 0; i < Settings.Keys; ++i) {
+		Frame += Random.RandRange(1, 60);
+		// mostly ease keyframes like in recorded scenes, with a few of every other kind
+		float Kind = Random.GetFraction();
+		FFICCurveKey Key(Random.FRandRange(-100000.0f, 100000.0f));
+		if (Kind < 0.1f) {
+			Key.Interpolation = EFICCurveInterpolation::Linear;
+		} else if (Kind < 0.15f) {
+			Key.Interpolation = EFICCurveInterpolation::Step;
+		} else if (Kind < 0.3f) {
+			Key.TangentMode = EFICCurveTangentMode::Flat;
+		} else if (Kind < 0.35f) {
+			Key.TangentMode = EFICCurveTangentMode::User;
+			Key.InTanTime = Key.OutTanTime = Random.FRandRange(0.0f, 20.0f);
+			Key.InTanValue = Key.OutTanValue = Random.FRandRange(-1000.0f, 1000.0f);
+		}
+		Keys.Add(TPair<FICFrame, FFICCurveKey>(Frame, Key));
+	}
+	// insertion in random order, like keyframes added all over the timeline in the editor
+	for (int32 i = Keys.Num() - 1; i > 0; --i) Keys.Swap(i, Random.RandRange(0, i));
+	return Keys;
+}
+
+static void BuildCurve(FFICCurve& Curve, const TArray<TPair<FICFrame, FFICCurveKey>>& Keys) {
+	Curve.Empty();
+	for (const TPair<FICFrame, FFICCurveKey>& Key : Keys) Curve.SetKey(Key.Key, Key.Value);
+}
+
+template<typename FuncType>
+static FFICBenchmarkResult Measure(const FString& Name, int64 Operations, int32 Iterations, FuncType Func) {
+	FFICBenchmarkResult Result;
+	Result.Name = Name;
+	Result.Operations = FMath::Max<int64>(Operations, 1);
+	for (int32 i = 0; i < Iterations; ++i) {
+		uint64 Start = FPlatformTime::Cycles64();
+		Result.Value = Func();
+		Result.Seconds.Add(FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - Start));
+	}
+	return Result;
+}
+
+/** Compares the cursor based evaluation and the serialization round trip against a freshly built curve, returns false on mismatch */
+static bool CheckCorrectness(FFICCurve& Curve, const FFICBenchmarkSettings& Settings) {
+	const TArray<FICFrame> Frames = Curve.GetFrames();
+	FRandomStream Random(Settings.Seed);
+
+	TArray<uint8> Data;
+	FMemoryWriter Writer(Data);
+	Curve.Serialize(Writer);
+	FFICCurve Loaded;
+	FMemoryReader Reader(Data);
+	Loaded.Serialize(Reader);
+	if (Reader.IsError() || Loaded.Num() != Curve.Num()) {
+		UE_LOG(LogFicsItCamBenchmark, Error, TEXT("Serialization round trip lost keys (%i of %i)"), Loaded.Num(), Curve.Num());
+		return false;
+	}
+	for (FICFrame Frame : Frames) {
+		if (!(*Loaded.GetKey(Frame) == *Curve.GetKey(Frame))) {
+			UE_LOG(LogFicsItCamBenchmark, Error, TEXT("Serialization round trip changed the key at frame %lld"), Frame);
+			return false;
+		}
+	}
+
+	for (int32 i = 0; i < Settings.Keys * 4; ++i) {
+		FICFrameFloat Time = Random.FRandRange((float)Frames[0] - 10, (float)Frames.Last() + 10);
+		FICValue Sequential = Curve.Evaluate(Time);
+		FFICCurve Fresh = Curve;
+		FICValue Reference = Fresh.Evaluate(Time);
+		if (Sequential != Reference || Loaded.Evaluate(Time) != Reference) {
+			UE_LOG(LogFicsItCamBenchmark, Error, TEXT("Evaluation at %f differs: %f (cursor) %f (fresh) %f (loaded)"), Time, Sequential, Reference, Loaded.Evaluate(Time));
+			return false;
+		}
+	}
+	return true;
+}
+
+/**
+ * Compares the results against the results of another build (f.e. a unoptimized Debug build) written with -csv.
+ * Returns false if a benchmark computed a different value, or if the evaluation benchmarks aren't at least the minimum speedup faster.
+ */
+static bool CompareResults(const TArray<FFICBenchmarkResult>& Results, const FFICBenchmarkSettings& Settings) {
+	TArray<FString> Lines;
+	if (!FFileHelper::LoadFileToStringArray(Lines, *Settings.ComparePath)) {
+		UE_LOG(LogFicsItCamBenchmark, Error, TEXT("Unable to read results to compare against from '%s'"), *Settings.ComparePath);
+		return false;
+	}
+
+	bool bPassed = true;
+	int32 Compared = 0;
+	for (const FString& Line : Lines) {
+		TArray<FString> Columns;
+		Line.ParseIntoArray(Columns, TEXT(","));
+		if (Columns.Num() < 6 || FCString::Atoi(*Columns[1]) != Settings.Keys) continue;
+		const FFICBenchmarkResult* Result = Results.FindByPredicate([&](const FFICBenchmarkResult& Result) {
+			return Result.Name == Columns[0];
+		});
+		if (!Result) continue;
+		++Compared;
+
+		double OtherMedianNs = FCString::Atod(*Columns[4]);
+		double OtherValue = FCString::Atod(*Columns[5]);
+		double Speedup = OtherMedianNs / FMath::Max(Result->GetMedianNs(), 0.001);
+		UE_LOG(LogFicsItCamBenchmark, Display, TEXT("%-20s %10.2fx faster than the compared build"), *Result->Name, Speedup);
+
+		// both builds have to compute the same, differences mean code depends on how it got optimized
+		if (FMath::Abs(Result->Value - OtherValue) > FMath::Max(FMath::Abs(OtherValue), 1.0) * 1e-5) {
+			UE_LOG(LogFicsItCamBenchmark, Error, TEXT("%s computed %.17g, the compared build %.17g"), *Result->Name, Result->Value, OtherValue);
+			bPassed = false;
+		}
+		if (Result->Name.StartsWith(TEXT("Evaluate")) && Speedup < Settings.MinSpeedup) {
+			UE_LOG(LogFicsItCamBenchmark, Error, TEXT("%s is only %.2fx faster than the compared build, at least %.2fx are required"), *Result->Name, Speedup, Settings.MinSpeedup);
+			bPassed = false;
+		}
+	}
+	if (Compared < 1) {
+		UE_LOG(LogFicsItCamBenchmark, Error, TEXT("'%s' contains no results of %i keys to compare against"), *Settings.ComparePath, Settings.Keys);
+		return false;
+	}
+	return bPassed;
+}
+
+static int32 RunBenchmarks(const FFICBenchmarkSettings& Settings) {
+	TArray<TPair<FICFrame, FFICCurveKey>> Keys = GenerateKeys(Settings);
+	FFICCurve Curve;
+	BuildCurve(Curve, Keys);
+	const TArray<FICFrame> Frames = Curve.GetFrames();
+
+	if (!CheckCorrectness(Curve, Settings)) return 1;
+
+	// evaluates four sub-frames per frame, like rendering with motion blur
+	const int64 SequentialSamples = (Frames.Last() - Frames[0]) * 4;
+	TArray<FICFrameFloat> RandomTimes;
+	FRandomStream Random(Settings.Seed);
+	for (int32 i = 0; i < Settings.Keys * 4; ++i) RandomTimes.Add(Random.FRandRange((float)Frames[0], (float)Frames.Last()));
+
+	TArray<uint8> Data;
+	{
+		FMemoryWriter Writer(Data);
+		Curve.Serialize(Writer);
+	}
+
+	TArray<FFICBenchmarkResult> Results;
+	Results.Add(Measure(TEXT("Insert"), Keys.Num(), Settings.Iterations, [&]() {
+		FFICCurve Target;
+		BuildCurve(Target, Keys);
+		return (double)Target.Num();
+	}));
+	Results.Add(Measure(TEXT("EvaluateSequential"), SequentialSamples, Settings.Iterations, [&]() {
+		double Sum = 0.0;
+		for (int64 i = 0; i < SequentialSamples; ++i) Sum += Curve.Evaluate(Frames[0] + i * 0.25f);
+		return Sum;
+	}));
+	Results.Add(Measure(TEXT("EvaluateRandom"), RandomTimes.Num(), Settings.Iterations, [&]() {
+		double Sum = 0.0;
+		for (FICFrameFloat Time : RandomTimes) Sum += Curve.Evaluate(Time);
+		return Sum;
+	}));
+	Results.Add(Measure(TEXT("Recalculate"), Frames.Num(), Settings.Iterations, [&]() {
+		double Sum = 0.0;
+		for (FICFrame Frame : Frames) {
+			Curve.RecalculateKey(Frame);
+			const FFICCurveKey* Key = Curve.GetKey(Frame);
+			Sum += Key->InTanValue + Key->OutTanValue;
+		}
+		return Sum;
+	}));
+	Results.Add(Measure(TEXT("Serialize"), Frames.Num(), Settings.Iterations, [&]() {
+		TArray<uint8> Buffer;
+		Buffer.Reserve(Data.Num());
+		FMemoryWriter Writer(Buffer);
+		Curve.Serialize(Writer);
+		return (double)Buffer.Num();
+	}));
+	Results.Add(Measure(TEXT("Deserialize"), Frames.Num(), Settings.Iterations, [&]() {
+		FFICCurve Loaded;
+		FMemoryReader Reader(Data);
+		Loaded.Serialize(Reader);
+		return (double)Loaded.Num();
+	}));
+	// copying the whole curve is what the undo history does for every change of an attribute
+	Results.Add(Measure(TEXT("Snapshot"), Frames.Num(), Settings.Iterations, [&]() {
+		FFICCurve Copy = Curve;
+		return (double)Copy.Num();
+	}));
+
+	UE_LOG(LogFicsItCamBenchmark, Display, TEXT("%i keys, %i iterations, seed %i, %i bytes serialized (%.2f bytes per key)"), Settings.Keys, Settings.Iterations, Settings.Seed, Data.Num(), (float)Data.Num() / Frames.Num());
+	FString CSV = TEXT("Benchmark,Keys,Operations,MinNs,MedianNs,Value") LINE_TERMINATOR;
+	for (const FFICBenchmarkResult& Result : Results) {
+		UE_LOG(LogFicsItCamBenchmark, Display, TEXT("%-20s %10.1f ns/op (min) %10.1f ns/op (median)"), *Result.Name, Result.GetMinNs(), Result.GetMedianNs());
+		CSV += FString::Printf(TEXT("%s,%i,%lld,%.1f,%.1f,%.17g"), *Result.Name, Settings.Keys, Result.Operations, Result.GetMinNs(), Result.GetMedianNs(), Result.Value) + LINE_TERMINATOR;
+	}
+
+	if (!Settings.CSVPath.IsEmpty() && !FFileHelper::SaveStringToFile(CSV, *Settings.CSVPath)) {
+		UE_LOG(LogFicsItCamBenchmark, Error, TEXT("Unable to write results to '%s'"), *Settings.CSVPath);
+		return 1;
+	}
+	if (!Settings.ComparePath.IsEmpty() && !CompareResults(Results, Settings)) return 1;
+	return 0;
+}
+
+INT32_MAIN_INT32_ARGC_TCHAR_ARGV() {
+	GEngineLoop.PreInit(ArgC, ArgV);
+
+	FFICBenchmarkSettings Settings;
+	FParse::Value(FCommandLine::Get(), TEXT("-keys="), Settings.Keys);
+	FParse::Value(FCommandLine::Get(), TEXT("-iterations="), Settings.Iterations);
+	FParse::Value(FCommandLine::Get(), TEXT("-seed="), Settings.Seed);
+	FParse::Value(FCommandLine::Get(), TEXT("-csv="), Settings.CSVPath);
+	FParse::Value(FCommandLine::Get(), TEXT("-compare="), Settings.ComparePath);
+	FParse::Value(FCommandLine::Get(), TEXT("-minspeedup="), Settings.MinSpeedup);
+	Settings.Keys = FMath::Max(Settings.Keys, 2);
+	Settings.Iterations = FMath::Max(Settings.Iterations, 1);
+
+	int32 Result = RunBenchmarks(Settings);
+
+	FEngineLoop::AppPreExit();
+	FEngineLoop::AppExit();
+	return Result;
+}
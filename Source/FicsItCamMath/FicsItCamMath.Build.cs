@@ -0,0 +1,20 @@
+using UnrealBuildTool;
+
+/**
+ * Keyframe and interpolation math of FicsIt-Cam, only depends on Core
+ * so it can be used without the game and its UObject types.
+ */
+public class FicsItCamMath : ModuleRules
+{
+    public FicsItCamMath(ReadOnlyTargetRules Target) : base(Target)
+    {
+        PCHUsage = PCHUsageMode.UseExplicitOrSharedPCHs;
+
+		PublicDependencyModuleNames.AddRange(new string[] {
+            "Core"
+		});
+
+        bUseUnity = true;
+        OptimizeCode = CodeOptimization.InNonDebugBuilds;
+    }
+}
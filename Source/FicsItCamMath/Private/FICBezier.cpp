@@ -0,0 +1,27 @@
+#include "FICBezier.h"
+
+float FFICBezier::Interpolate(FVector2D P0, FVector2D P1, FVector2D P2, FVector2D P3, float t) {
+	// power basis coefficients, so every bisection step is a single horner evaluation for time and value
+	FVector2D A = P3 - P0 + 3.0f * (P1 - P2);
+	FVector2D B = 3.0f * (P0 - 2.0f * P1 + P2);
+	FVector2D C = 3.0f * (P1 - P0);
+	
+	float Lower = 0.0;
+	float Upper = 1.0;
+	float Current = 0.5;
+	float CurrentT;
+	float CurrentV;
+	int Increments = 0;
+	do {
+		FVector2D Point = ((A * Current + B) * Current + C) * Current + P0;
+		CurrentT = Point.X;
+		CurrentV = Point.Y;
+		if (CurrentT < t) {
+			Lower = Current;
+		} else if (CurrentT > t) {
+			Upper = Current;
+		}
+		Current = Lower + ((Upper - Lower)/2.0);
+	} while (FMath::Abs(t - CurrentT) > 0.001 && Increments++ < 100);
+	return CurrentV;
+}
@@ -0,0 +1,179 @@
+#include "FICCurve.h"
+
+#include "Algo/BinarySearch.h"
+#include "FICBezier.h"
+#include "FICEncoding.h"
+
+bool FFICCurveKey::operator==(const FFICCurveKey& Other) const {
+	return Value == Other.Value
+		&& InTanTime == Other.InTanTime && InTanValue == Other.InTanValue
+		&& OutTanTime == Other.OutTanTime && OutTanValue == Other.OutTanValue
+		&& Interpolation == Other.Interpolation && TangentMode == Other.TangentMode;
+}
+
+int32 FFICCurveMath::FindSegment(const TArray<FICFrame>& Frames, FICFrameFloat Time, int32& InOutCursor) {
+	int32 Next = InOutCursor;
+	if (!Frames.IsValidIndex(Next) || Frames[Next] <= Time || (Next > 0 && Frames[Next-1] > Time)) {
+		Next = Algo::UpperBound(Frames, Time);
+		InOutCursor = Next;
+	}
+	return Next;
+}
+
+FICValue FFICCurveMath::EvaluateSegment(EFICCurveInterpolation Interpolation, FICFrameFloat Time1, FICValue Value1, FICFrameFloat OutTanTime1, FICValue OutTanValue1, FICFrameFloat Time2, FICValue Value2, FICFrameFloat InTanTime2, FICValue InTanValue2, FICFrameFloat Time) {
+	switch (Interpolation) {
+	case EFICCurveInterpolation::Step:
+		return Value1;
+	case EFICCurveInterpolation::Linear:
+		return FMath::Lerp(Value1, Value2, (Time - Time1) / (Time2 - Time1));
+	default:
+		FICFrameFloat Duration = Time2 - Time1;
+		FICValue Delta = Value2 - Value1;
+		return Value1 + FFICBezier::Interpolate({0, 0}, {OutTanTime1, OutTanValue1},
+			{Duration - InTanTime2, Delta - InTanValue2}, {Duration, Delta}, Time - Time1);
+	}
+}
+
+void FFICCurveMath::RecalculateTangents(EFICCurveTangentMode Mode, FICFrame Time, FFICCurveKey& Key, const FFICCurveKey* Prev, FICFrame PrevTime, const FFICCurveKey* Next, FICFrame NextTime) {
+	if (Mode == EFICCurveTangentMode::User) return;
+	float Factor = 1.0/3.0;
+	if (Prev) {
+		float PrevTimeDiff = Time - PrevTime;
+		float PrevValueDiff = Key.Value - Prev->Value;
+		if (Next) {
+			float NextTimeDiff = NextTime - Time;
+			float NextValueDiff = Next->Value - Key.Value;
+			float TimeDiff = NextTime - PrevTime;
+
+			Key.OutTanTime = NextTimeDiff * Factor;
+			Key.InTanTime = PrevTimeDiff * Factor;
+
+			float Ratio = PrevTimeDiff / TimeDiff;
+			float Slope = (PrevValueDiff/PrevTimeDiff) * (1-Ratio) + (NextValueDiff/NextTimeDiff) * Ratio;
+			
+			if (Mode == EFICCurveTangentMode::Auto) {
+				if ((Key.Value < Prev->Value && Key.Value < Next->Value) || (Key.Value > Prev->Value && Key.Value > Next->Value)) {
+					Key.InTanValue = Key.OutTanValue = 0;
+				} else {
+					// the handles may not leave the value range of the neighbours, the flatter side limits both
+					float Min = FMath::Min(Prev->Value, Next->Value);
+					float Max = FMath::Max(Prev->Value, Next->Value);
+					Key.InTanValue = FMath::Clamp(Key.Value - Slope * Key.InTanTime, Min, Max) - Key.Value;
+					Key.OutTanValue = FMath::Clamp(Key.Value + Slope * Key.OutTanTime, Min, Max) - Key.Value;
+					float InSlope = -Key.InTanValue/Key.InTanTime;
+					float OutSlope = Key.OutTanValue/Key.OutTanTime;
+					Slope = FMath::Abs(InSlope) < FMath::Abs(OutSlope) ? InSlope : OutSlope;
+					Key.InTanValue = Slope * Key.InTanTime;
+					Key.OutTanValue = Slope * Key.OutTanTime;
+				}
+			} else {
+				Key.OutTanValue = 0;
+				Key.InTanValue = 0;
+			}
+		} else {
+			if (Mode == EFICCurveTangentMode::Auto) {
+				Key.InTanTime = Key.InTanValue = 0;
+			} else {
+				Key.InTanTime = PrevTimeDiff * Factor;
+				Key.InTanValue = 0;
+			}
+		}
+	} else if (Next) {
+		float NextTimeDiff = NextTime - Time;
+		if (Mode == EFICCurveTangentMode::Auto) {
+			Key.OutTanTime = Key.OutTanValue = 0;
+		} else {
+			Key.OutTanTime = NextTimeDiff * Factor;
+			Key.OutTanValue = 0;
+		}
+	}
+}
+
+void FFICCurve::SetKey(FICFrame Time, const FFICCurveKey& Key) {
+	if (!Keys.Contains(Time)) FrameIndex.Add(Time);
+	Keys.FindOrAdd(Time) = Key;
+	FICFrame Neighbour;
+	RecalculateKey(Time);
+	if (FFICFrameIndex::FindPrev(GetFrames(), Time, Neighbour)) RecalculateKey(Neighbour);
+	if (FFICFrameIndex::FindNext(GetFrames(), Time, Neighbour)) RecalculateKey(Neighbour);
+}
+
+void FFICCurve::RemoveKey(FICFrame Time) {
+	if (Keys.Remove(Time) < 1) return;
+	FrameIndex.Remove(Time);
+	FICFrame Neighbour;
+	if (FFICFrameIndex::FindPrev(GetFrames(), Time, Neighbour)) RecalculateKey(Neighbour);
+	if (FFICFrameIndex::FindNext(GetFrames(), Time, Neighbour)) RecalculateKey(Neighbour);
+}
+
+void FFICCurve::RecalculateKey(FICFrame Time) {
+	FFICCurveKey* Key = Keys.Find(Time);
+	if (!Key) return;
+	FICFrame PrevTime = 0, NextTime = 0;
+	const FFICCurveKey* Prev = FFICFrameIndex::FindPrev(GetFrames(), Time, PrevTime) ? Keys.Find(PrevTime) : nullptr;
+	const FFICCurveKey* Next = FFICFrameIndex::FindNext(GetFrames(), Time, NextTime) ? Keys.Find(NextTime) : nullptr;
+	FFICCurveMath::RecalculateTangents(Key->TangentMode, Time, *Key, Prev, PrevTime, Next, NextTime);
+}
+
+void FFICCurve::Empty() {
+	Keys.Empty();
+	FrameIndex.Invalidate();
+	SegmentCursor = 0;
+}
+
+FICValue FFICCurve::Evaluate(FICFrameFloat Time) {
+	const TArray<FICFrame>& Frames = GetFrames();
+	if (Frames.Num() < 1) return FallBackValue;
+
+	int32 Next = FFICCurveMath::FindSegment(Frames, Time, SegmentCursor);
+	if (Next < 1) return Keys[Frames[0]].Value;
+	if (Next >= Frames.Num()) return Keys[Frames.Last()].Value;
+
+	const FFICCurveKey& Key1 = Keys[Frames[Next-1]];
+	const FFICCurveKey& Key2 = Keys[Frames[Next]];
+	return FFICCurveMath::EvaluateSegment(Key1.Interpolation, (FICFrameFloat)Frames[Next-1], Key1.Value, Key1.OutTanTime, Key1.OutTanValue, (FICFrameFloat)Frames[Next], Key2.Value, Key2.InTanTime, Key2.InTanValue, Time);
+}
+
+void FFICCurve::Serialize(FArchive& Ar) {
+	TArray<FICFrame> Frames;
+	if (Ar.IsSaving()) Frames = GetFrames();
+	FFICEncoding::SerializeFrames(Ar, Frames);
+	if (Ar.IsError()) return;
+
+	// lower 2 bits interpolation, next 2 bits tangent mode, 5th bit set if the key has tangents
+	TArray<uint8> Flags;
+	if (Ar.IsSaving()) {
+		Flags.Reserve(Frames.Num());
+		for (FICFrame Frame : Frames) {
+			const FFICCurveKey& Key = Keys[Frame];
+			bool bHasTangents = Key.InTanValue != 0.0f || Key.InTanTime != 0.0f || Key.OutTanValue != 0.0f || Key.OutTanTime != 0.0f;
+			Flags.Add((uint8)Key.Interpolation | ((uint8)Key.TangentMode << 2) | (bHasTangents ? 0x10 : 0));
+		}
+	} else {
+		Flags.SetNumZeroed(Frames.Num());
+	}
+	Ar.Serialize(Flags.GetData(), Flags.Num());
+
+	TMap<FICFrame, FFICCurveKey> LoadedKeys;
+	if (Ar.IsLoading()) LoadedKeys.Reserve(Frames.Num());
+	for (int32 i = 0; i < Frames.Num() && !Ar.IsError(); ++i) {
+		FFICCurveKey& Key = Ar.IsSaving() ? Keys[Frames[i]] : LoadedKeys.Add(Frames[i]);
+		Ar << Key.Value;
+		if (Flags[i] & 0x10) {
+			Ar << Key.InTanValue;
+			Ar << Key.InTanTime;
+			Ar << Key.OutTanValue;
+			Ar << Key.OutTanTime;
+		}
+		if (Ar.IsLoading()) {
+			Key.Interpolation = (EFICCurveInterpolation)FMath::Min<uint8>(Flags[i] & 0x3, (uint8)EFICCurveInterpolation::Step);
+			Key.TangentMode = (EFICCurveTangentMode)FMath::Min<uint8>((Flags[i] >> 2) & 0x3, (uint8)EFICCurveTangentMode::User);
+		}
+	}
+
+	if (Ar.IsLoading() && !Ar.IsError()) {
+		Keys = MoveTemp(LoadedKeys);
+		FrameIndex.Invalidate();
+		SegmentCursor = 0;
+	}
+}
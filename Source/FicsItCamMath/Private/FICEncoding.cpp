@@ -0,0 +1,63 @@
+#include "FICEncoding.h"
+
+void FFICEncoding::SerializeVarInt(FArchive& Ar, uint64& Value) {
+	if (Ar.IsLoading()) {
+		Value = 0;
+		for (int32 Shift = 0; Shift < 64; Shift += 7) {
+			uint8 Byte = 0;
+			Ar << Byte;
+			Value |= (uint64)(Byte & 0x7F) << Shift;
+			if (!(Byte & 0x80) || Ar.IsError()) return;
+		}
+		Ar.SetError();
+	} else {
+		uint64 Remaining = Value;
+		do {
+			uint8 Byte = Remaining & 0x7F;
+			Remaining >>= 7;
+			if (Remaining) Byte |= 0x80;
+			Ar << Byte;
+		} while (Remaining);
+	}
+}
+
+void FFICEncoding::SerializeFrames(FArchive& Ar, TArray<FICFrame>& Frames) {
+	uint64 Num = Frames.Num();
+	SerializeVarInt(Ar, Num);
+	if (Ar.IsLoading()) {
+		// every frame takes at least one byte
+		if (Num > (uint64)(Ar.TotalSize() - Ar.Tell())) {
+			Ar.SetError();
+			return;
+		}
+		Frames.SetNumUninitialized(Num);
+	}
+	
+	FICFrame Previous = 0;
+	for (FICFrame& Frame : Frames) {
+		uint64 ZigZag = 0;
+		if (Ar.IsSaving()) {
+			int64 Delta = Frame - Previous;
+			ZigZag = ((uint64)Delta << 1) ^ (uint64)(Delta >> 63);
+		}
+		SerializeVarInt(Ar, ZigZag);
+		if (Ar.IsLoading()) {
+			int64 Delta = (int64)(ZigZag >> 1) ^ -(int64)(ZigZag & 1);
+			Frame = Previous + Delta;
+		}
+		Previous = Frame;
+	}
+}
+
+void FFICEncoding::SerializeNibbles(FArchive& Ar, TArray<uint8>& Nibbles, int32 Num) {
+	if (Ar.IsLoading()) Nibbles.SetNumZeroed(Num);
+	for (int32 i = 0; i < Num; i += 2) {
+		uint8 Byte = 0;
+		if (Ar.IsSaving()) Byte = (Nibbles[i] & 0xF) | (i+1 < Num ? (Nibbles[i+1] & 0xF) << 4 : 0);
+		Ar << Byte;
+		if (Ar.IsLoading()) {
+			Nibbles[i] = Byte & 0xF;
+			if (i+1 < Num) Nibbles[i+1] = Byte >> 4;
+		}
+	}
+}
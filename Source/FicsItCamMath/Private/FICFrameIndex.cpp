@@ -0,0 +1,30 @@
+#include "FICFrameIndex.h"
+
+#include "Algo/BinarySearch.h"
+
+void FFICFrameIndex::Add(FICFrame Frame) {
+	if (!bValid) return;
+	int32 Index = Algo::LowerBound(Frames, Frame);
+	if (Frames.IsValidIndex(Index) && Frames[Index] == Frame) return;
+	Frames.Insert(Frame, Index);
+}
+
+void FFICFrameIndex::Remove(FICFrame Frame) {
+	if (!bValid) return;
+	int32 Index = Algo::BinarySearch(Frames, Frame);
+	if (Index != INDEX_NONE) Frames.RemoveAt(Index);
+}
+
+bool FFICFrameIndex::FindPrev(const TArray<FICFrame>& InFrames, FICFrame Time, FICFrame& OutTime) {
+	int32 Index = Algo::LowerBound(InFrames, Time) - 1;
+	if (!InFrames.IsValidIndex(Index)) return false;
+	OutTime = InFrames[Index];
+	return true;
+}
+
+bool FFICFrameIndex::FindNext(const TArray<FICFrame>& InFrames, FICFrame Time, FICFrame& OutTime) {
+	int32 Index = Algo::UpperBound(InFrames, Time);
+	if (!InFrames.IsValidIndex(Index)) return false;
+	OutTime = InFrames[Index];
+	return true;
+}
@@ -0,0 +1,12 @@
+#pragma once
+
+#include "FICMathTypes.h"
+
+class FICSITCAMMATH_API FFICBezier {
+public:
+	/**
+	 * Returns the value of the cubic bezier curve given by the four time-value control points at the given time.
+	 * The curve parameter of the time is found by bisection, so the times of the control points have to be monotonic.
+	 */
+	static float Interpolate(FVector2D P0, FVector2D P1, FVector2D P2, FVector2D P3, float t);
+};
@@ -0,0 +1,92 @@
+#pragma once
+
+#include "FICFrameIndex.h"
+#include "FICMathTypes.h"
+
+/** How the segment from a key to the next key gets interpolated */
+enum class EFICCurveInterpolation : uint8 {
+	Bezier,
+	Linear,
+	Step,
+};
+
+/** How the tangents of a key get calculated when the key or its neighbours change */
+enum class EFICCurveTangentMode : uint8 {
+	/** Smooth tangents, flat at local extrema so the curve doesn't overshoot */
+	Auto,
+	/** Flat tangents, eases in and out of every key */
+	Flat,
+	/** Tangents are set by the user and kept as they are */
+	User,
+};
+
+/**
+ * Key of a float curve, the tangents are the time-value offsets of the bezier handles relative to the key.
+ */
+struct FICSITCAMMATH_API FFICCurveKey {
+	FICValue Value = 0.0f;
+	FICFrameFloat InTanTime = 0.0f;
+	FICValue InTanValue = 0.0f;
+	FICFrameFloat OutTanTime = 0.0f;
+	FICValue OutTanValue = 0.0f;
+	EFICCurveInterpolation Interpolation = EFICCurveInterpolation::Bezier;
+	EFICCurveTangentMode TangentMode = EFICCurveTangentMode::Auto;
+
+	FFICCurveKey() = default;
+	FFICCurveKey(FICValue Value, EFICCurveInterpolation Interpolation = EFICCurveInterpolation::Bezier, EFICCurveTangentMode TangentMode = EFICCurveTangentMode::Auto) : Value(Value), Interpolation(Interpolation), TangentMode(TangentMode) {}
+
+	bool operator==(const FFICCurveKey& Other) const;
+};
+
+/**
+ * Evaluation and tangent calculation of keyframe curves, shared by the float attributes of scenes and FFICCurve.
+ */
+class FICSITCAMMATH_API FFICCurveMath {
+public:
+	/**
+	 * Returns the index of the first of the given sorted frames after the given time.
+	 * The given cursor is reused as long as the time stays within its segment, so sequential evaluation doesn't search.
+	 */
+	static int32 FindSegment(const TArray<FICFrame>& Frames, FICFrameFloat Time, int32& InOutCursor);
+
+	/**
+	 * Returns the value of the segment between the given keys at the given time.
+	 * Bezier segments are evaluated relative to the first key, so large values (like world positions far away from the origin)
+	 * only lose precision when adding the first value back instead of in every term of the curve.
+	 */
+	static FICValue EvaluateSegment(EFICCurveInterpolation Interpolation, FICFrameFloat Time1, FICValue Value1, FICFrameFloat OutTanTime1, FICValue OutTanValue1, FICFrameFloat Time2, FICValue Value2, FICFrameFloat InTanTime2, FICValue InTanValue2, FICFrameFloat Time);
+
+	/**
+	 * Calculates the tangents of the given key from its neighbouring keys (if any) according to the given tangent mode.
+	 */
+	static void RecalculateTangents(EFICCurveTangentMode Mode, FICFrame Time, FFICCurveKey& Key, const FFICCurveKey* Prev, FICFrame PrevTime, const FFICCurveKey* Next, FICFrame NextTime);
+};
+
+/**
+ * Keyframe curve without any game or reflection dependencies.
+ * Stores its keys the same way FFICFloatAttribute does, so tools and benchmarks get comparable results.
+ */
+class FICSITCAMMATH_API FFICCurve {
+private:
+	TMap<FICFrame, FFICCurveKey> Keys;
+	FFICFrameIndex FrameIndex;
+	int32 SegmentCursor = 0;
+
+public:
+	FICValue FallBackValue = 0.0f;
+
+	int32 Num() const { return Keys.Num(); }
+	const TArray<FICFrame>& GetFrames() { return FrameIndex.Get(Keys); }
+	const FFICCurveKey* GetKey(FICFrame Time) const { return Keys.Find(Time); }
+
+	/** Adds or replaces the key at the given time and recalculates the tangents of it and its neighbours */
+	void SetKey(FICFrame Time, const FFICCurveKey& Key);
+	void RemoveKey(FICFrame Time);
+	void RecalculateKey(FICFrame Time);
+	void Empty();
+
+	FICValue Evaluate(FICFrameFloat Time);
+
+	/** Like the keyframe blocks of float attributes: frames, a flag byte per key (interpolation, tangent mode), then values and tangents */
+	void Serialize(FArchive& Ar);
+};
@@ -0,0 +1,15 @@
+#pragma once
+
+#include "FICMathTypes.h"
+
+/**
+ * Compact binary encodings used by the keyframe blobs of scenes and scene files.
+ */
+class FICSITCAMMATH_API FFICEncoding {
+public:
+	static void SerializeVarInt(FArchive& Ar, uint64& Value);
+	/** Sorted frames, stored as zigzag encoded deltas */
+	static void SerializeFrames(FArchive& Ar, TArray<FICFrame>& Frames);
+	/** 4-bit values packed two per byte, the amount of values has to be known already when loading */
+	static void SerializeNibbles(FArchive& Ar, TArray<uint8>& Nibbles, int32 Num);
+};
@@ -0,0 +1,34 @@
+#pragma once
+
+#include "FICMathTypes.h"
+
+/**
+ * Sorted list of the keyframe frames of a attribute, kept up to date by the attribute on keyframe add and remove.
+ * Allows to find neighbouring keyframes with a binary search instead of sorting all keyframes.
+ */
+struct FICSITCAMMATH_API FFICFrameIndex {
+private:
+	TArray<FICFrame> Frames;
+	bool bValid = false;
+
+public:
+	void Invalidate() { bValid = false; Frames.Empty(); }
+	void Add(FICFrame Frame);
+	void Remove(FICFrame Frame);
+
+	template<typename MapType>
+	const TArray<FICFrame>& Get(const MapType& Keyframes) {
+		if (!bValid) {
+			Keyframes.GetKeys(Frames);
+			Frames.Sort();
+			bValid = true;
+		}
+		return Frames;
+	}
+
+	/**
+	 * Finds the closest frame before/after the given frame in the given sorted frames, returns false if there is none.
+	 */
+	static bool FindPrev(const TArray<FICFrame>& InFrames, FICFrame Time, FICFrame& OutTime);
+	static bool FindNext(const TArray<FICFrame>& InFrames, FICFrame Time, FICFrame& OutTime);
+};
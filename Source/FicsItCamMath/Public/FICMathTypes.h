@@ -0,0 +1,7 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+typedef int64 FICFrame;
+typedef float FICFrameFloat;
+typedef float FICValue;